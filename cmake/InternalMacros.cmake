@@ -31,7 +31,7 @@ set_package_properties(gzip PROPERTIES
 )
 
 function(generate_svgz svg_file svgz_file target_prefix)
-    cmake_parse_arguments(ARGS "NO_CLEANING" "" "" ${ARGN})
+    cmake_parse_arguments(ARGS "NO_CLEANING" "SVG_FILE_VARIABLE" "" ${ARGN})
 
     if (NOT IS_ABSOLUTE ${svg_file})
         set(svg_file "${CMAKE_CURRENT_SOURCE_DIR}/${svg_file}")
@@ -112,7 +112,15 @@ function(generate_svgz svg_file svgz_file target_prefix)
     endif()
 
     add_custom_target("${target_prefix}${_fileName}z" ALL DEPENDS ${svgz_file})
+
+    # the SVG file which got compressed, possibly the cleaned one
+    if(ARGS_SVG_FILE_VARIABLE)
+        set(${ARGS_SVG_FILE_VARIABLE} ${svg_file} PARENT_SCOPE)
+    endif()
 endfunction()
 
 # setup generral renderig check target
 add_custom_target(check_rendering)
+
+# setup check target for tile sizes derived by downsampling
+add_custom_target(check_mipmaps)
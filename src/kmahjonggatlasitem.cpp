@@ -0,0 +1,183 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+// own
+#include "kmahjonggatlasitem.h"
+
+// Qt
+#include <QQuickWindow>
+#include <QSGImageNode>
+#include <QSGNode>
+#include <QSGTexture>
+
+// LibKMahjongg
+#include "kmahjonggimageprovider.h"
+#include "kmahjonggtileset.h"
+
+namespace
+{
+constexpr int elementCount = 2 * KMahjonggTileset::BodyCount + KMahjonggTileset::FaceCount;
+
+// owns the atlas texture shared by all its child image nodes
+class KMahjonggAtlasNode : public QSGNode
+{
+public:
+    ~KMahjonggAtlasNode() override
+    {
+        // the children use the texture, so go first
+        deleteImageNodes();
+    }
+
+    void deleteImageNodes()
+    {
+        while (QSGNode *child = firstChild()) {
+            removeChildNode(child);
+            delete child;
+        }
+    }
+
+public:
+    std::unique_ptr<QSGTexture> texture;
+    QSize deviceTileSize;
+    QSize deviceFaceSize;
+};
+}
+
+class KMahjonggAtlasItemPrivate
+{
+public:
+    const KMahjonggTileset *tileset = nullptr;
+    QSize tileSize;
+    QList<KMahjonggAtlasItem::Placement> placements;
+    bool atlasDirty = true;
+    bool placementsDirty = true;
+};
+
+KMahjonggAtlasItem::KMahjonggAtlasItem(QQuickItem *parent)
+    : QQuickItem(parent)
+    , d_ptr(new KMahjonggAtlasItemPrivate)
+{
+    setFlag(ItemHasContents, true);
+}
+
+KMahjonggAtlasItem::~KMahjonggAtlasItem() = default;
+
+void KMahjonggAtlasItem::setTileset(const KMahjonggTileset *tileset)
+{
+    Q_D(KMahjonggAtlasItem);
+
+    if (d->tileset == tileset) {
+        return;
+    }
+    d->tileset = tileset;
+    invalidateAtlas();
+}
+
+const KMahjonggTileset *KMahjonggAtlasItem::tileset() const
+{
+    Q_D(const KMahjonggAtlasItem);
+
+    return d->tileset;
+}
+
+void KMahjonggAtlasItem::setTileSize(QSize size)
+{
+    Q_D(KMahjonggAtlasItem);
+
+    if (d->tileSize == size) {
+        return;
+    }
+    d->tileSize = size;
+    invalidateAtlas();
+    Q_EMIT tileSizeChanged();
+}
+
+QSize KMahjonggAtlasItem::tileSize() const
+{
+    Q_D(const KMahjonggAtlasItem);
+
+    return d->tileSize;
+}
+
+void KMahjonggAtlasItem::setPlacements(const QList<Placement> &placements)
+{
+    Q_D(KMahjonggAtlasItem);
+
+    d->placements = placements;
+    d->placementsDirty = true;
+    update();
+}
+
+QList<KMahjonggAtlasItem::Placement> KMahjonggAtlasItem::placements() const
+{
+    Q_D(const KMahjonggAtlasItem);
+
+    return d->placements;
+}
+
+void KMahjonggAtlasItem::invalidateAtlas()
+{
+    Q_D(KMahjonggAtlasItem);
+
+    d->atlasDirty = true;
+    update();
+}
+
+QSGNode *KMahjonggAtlasItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data)
+{
+    Q_D(KMahjonggAtlasItem);
+
+    Q_UNUSED(data);
+
+    // called on the render thread, with the GUI thread blocked
+    auto *node = static_cast<KMahjonggAtlasNode *>(oldNode);
+    QQuickWindow *const quickWindow = window();
+    if (!d->tileset || d->tileSize.isEmpty() || !quickWindow) {
+        delete node;
+        return nullptr;
+    }
+    if (!node) {
+        node = new KMahjonggAtlasNode;
+    }
+
+    const qreal dpr = quickWindow->effectiveDevicePixelRatio();
+    const QSize deviceTileSize = (QSizeF(d->tileSize) * dpr).toSize();
+    if (d->atlasDirty || !node->texture || node->deviceTileSize != deviceTileSize) {
+        node->deleteImageNodes();
+        QSize deviceFaceSize;
+        const QImage atlas = KMahjonggImageProvider::atlas(*d->tileset, deviceTileSize, &deviceFaceSize);
+        node->texture.reset(atlas.isNull() ? nullptr : quickWindow->createTextureFromImage(atlas));
+        node->deviceTileSize = deviceTileSize;
+        node->deviceFaceSize = deviceFaceSize;
+        d->atlasDirty = false;
+        d->placementsDirty = true;
+    }
+
+    if (d->placementsDirty) {
+        node->deleteImageNodes();
+        if (node->texture) {
+            for (const Placement &placement : std::as_const(d->placements)) {
+                if (placement.element < 0 || placement.element >= elementCount) {
+                    continue;
+                }
+                const QRect sourceRect = KMahjonggImageProvider::atlasRect(placement.element, node->deviceTileSize, node->deviceFaceSize);
+                // all nodes share texture and material, so the renderer merges them into one batch
+                QSGImageNode *imageNode = quickWindow->createImageNode();
+                imageNode->setTexture(node->texture.get());
+                imageNode->setOwnsTexture(false);
+                imageNode->setFiltering(QSGTexture::Linear);
+                imageNode->setSourceRect(sourceRect);
+                imageNode->setRect(QRectF(placement.position, QSizeF(sourceRect.size()) / dpr));
+                node->appendChildNode(imageNode);
+            }
+        }
+        d->placementsDirty = false;
+    }
+
+    return node;
+}
+
+#include "moc_kmahjonggatlasitem.cpp"
@@ -0,0 +1,86 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef KMAHJONGGATLASITEM_H
+#define KMAHJONGGATLASITEM_H
+
+// Qt
+#include <QList>
+#include <QPointF>
+#include <QQuickItem>
+// Std
+#include <memory>
+
+// LibKMahjongg
+#include <libkmahjonggquick_export.h>
+
+class KMahjonggTileset;
+class KMahjonggAtlasItemPrivate;
+
+/**
+ * @class KMahjonggAtlasItem kmahjonggatlasitem.h <KMahjonggAtlasItem>
+ *
+ * Qt Quick item drawing many tile elements from one atlas texture.
+ *
+ * The atlas is the one of KMahjonggImageProvider, uploaded once per tile size.
+ * Every placed element is a QSGImageNode showing its part of that texture,
+ * so the scene graph renderer can merge all of them into a single batch.
+ * Elements are numbered like in KMahjonggImageProvider::atlasRect() and drawn
+ * in the order given, so later ones are on top.
+ *
+ * Part of the separate KMahjongglib6Quick library target, only available if built with Qt Quick.
+ * The atlas is made with the thread-safe QImage getters of KMahjonggTileset,
+ * possibly on the scene graph render thread, so the tileset may not be loaded
+ * or resized while the item is visible. Call invalidateAtlas() afterwards.
+ * @code
+ * item->setTileset(&tileset);
+ * item->setTileSize(QSize(tileset.width(), tileset.height()));
+ * // two unselected tile bodies side by side
+ * item->setPlacements({{QPointF(0, 0), 0}, {QPointF(tileset.width(), 0), 0}});
+ * @endcode
+ */
+class LIBKMAHJONGGQUICK_EXPORT KMahjonggAtlasItem : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(QSize tileSize READ tileSize WRITE setTileSize NOTIFY tileSizeChanged)
+
+public:
+    struct Placement {
+        /// top-left corner, in item coordinates
+        QPointF position;
+        int element;
+    };
+
+    explicit KMahjonggAtlasItem(QQuickItem *parent = nullptr);
+    ~KMahjonggAtlasItem() override;
+
+    /// not owned, may be nullptr
+    void setTileset(const KMahjonggTileset *tileset);
+    const KMahjonggTileset *tileset() const;
+
+    /// size of a whole tile in logical pixels, the atlas is rendered for the device pixel ratio of the window
+    void setTileSize(QSize size);
+    QSize tileSize() const;
+
+    void setPlacements(const QList<Placement> &placements);
+    QList<Placement> placements() const;
+
+    /// makes the atlas get rendered again, e.g. after the tileset was reloaded
+    void invalidateAtlas();
+
+Q_SIGNALS:
+    void tileSizeChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) override;
+
+private:
+    std::unique_ptr<KMahjonggAtlasItemPrivate> const d_ptr;
+    Q_DECLARE_PRIVATE(KMahjonggAtlasItem)
+    Q_DISABLE_COPY(KMahjonggAtlasItem)
+};
+
+#endif // KMAHJONGGATLASITEM_H
@@ -9,12 +9,14 @@
 #include "kmahjonggbackground.h"
 
 // Qt
+#include <QCryptographicHash>
 #include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QPainter>
 #include <QPixmap>
-#include <QPixmapCache>
-#include <QSvgRenderer>
-#include <QGuiApplication>
+// Std
+#include <algorithm>
 
 // KF
 #include <KConfig>
@@ -22,6 +24,12 @@
 #include <KLocalizedString>
 
 // LibKMahjongg
+#include "kmahjonggcache_p.h"
+#include "kmahjonggdisplaylist_p.h"
+#include "kmahjonggproceduralbackground_p.h"
+#include "kmahjonggsnapshotcache_p.h"
+#include "kmahjonggsvgrendererpool_p.h"
+#include "kmahjonggutils_p.h"
 #include "libkmahjongg_debug.h"
 
 class KMahjonggBackgroundPrivate
@@ -40,8 +48,14 @@ public:
     QString authorName;
     QString authorEmailAddress;
 
-    QString pixmapCacheNameFromElementId(const QString &elementid, short width, short height);
-    QPixmap renderBG(short width, short height);
+    QString pixmapCacheNameFromElementId(const QString &elementid, short width, short height) const;
+    QImage renderBG(short width, short height, qreal dpr) const;
+    KMahjonggDisplayList displayListFor(QSize size) const;
+    void resetDisplayList();
+    QSize patternSize(qreal dpr) const;
+    QString textureCacheName(QSize patternSize) const;
+    QImage renderTexture(QSize patternSize, qreal dpr) const;
+    QByteArray computeFileHash() const;
 
     QPixmap backgroundPixmap;
     QBrush backgroundBrush;
@@ -49,8 +63,20 @@ public:
     QString graphicspath;
     short w = 1;
     short h = 1;
-
-    QSvgRenderer svg;
+    // minimal size in device pixels of the texture tiled backgrounds are repeated into
+    QSize textureSize = QSize(512, 512);
+
+    KMahjonggSvgRendererPool svg;
+    // used instead of svg if valid
+    KMahjonggProceduralBackground procedural;
+    // the whole SVG, recorded on the first rendering it is used for, guarded by displayListMutex
+    mutable KMahjonggDisplayList displayList;
+    mutable bool displayListRecorded = false;
+    mutable QMutex displayListMutex;
+    // images rendered by the thread-safe API
+    mutable KMahjonggSnapshotCache<QImage> imageCache;
+    // of the loaded file, only while watched by KMahjonggThemeWatcher
+    QByteArray fileHash;
 
     bool graphicsLoaded = false;
     bool isPlain = false;
@@ -76,7 +102,7 @@ bool KMahjonggBackground::loadDefault()
     return load(bgPath, 0, 0);
 }
 
-#define kBGVersionFormat 1
+#define kBGVersionFormat 2
 
 bool KMahjonggBackground::load(const QString &file, short width, short height)
 {
@@ -84,6 +110,7 @@ bool KMahjonggBackground::load(const QString &file, short width, short height)
 
     // qCDebug(LIBKMAHJONGG_LOG) << "Background loading";
     d->isSVG = false;
+    d->procedural = KMahjonggProceduralBackground();
 
     // qCDebug(LIBKMAHJONGG_LOG) << "Attempting to load .desktop at" << file;
 
@@ -122,6 +149,21 @@ bool KMahjonggBackground::load(const QString &file, short width, short height)
         return true;
     }
 
+    if (group.readEntry("Type", QString()) == QLatin1String("Procedural")) {
+        d->procedural = KMahjonggProceduralBackground::fromConfig(group);
+        if (!d->procedural.isValid()) {
+            return false;
+        }
+        d->graphicspath.clear();
+        d->isTiled = d->procedural.isTiled();
+        const QSize size = d->isTiled ? d->procedural.patternSize() : QSize(width, height);
+        d->w = size.width();
+        d->h = size.height();
+        d->graphicsLoaded = false;
+        d->filename = file;
+        return true;
+    }
+
     QString graphName = group.readEntry("FileName");
 
     d->graphicspath = QStandardPaths::locate(QStandardPaths::GenericDataLocation, QStringLiteral("kmahjongglib/backgrounds/") + graphName);
@@ -154,9 +196,16 @@ bool KMahjonggBackground::loadGraphics()
         return true;
     }
 
-    d->svg.load(d->graphicspath);
-    if (d->svg.isValid()) {
+    if (d->procedural.isValid()) {
+        // nothing to parse, generated on demand
+        d->imageCache.clear();
+        return true;
+    }
+
+    if (d->svg.load(d->graphicspath)) {
         d->isSVG = true;
+        d->resetDisplayList();
+        d->imageCache.clear();
     } else {
         // qCDebug(LIBKMAHJONGG_LOG) << "could not load svg";
         return false;
@@ -178,48 +227,225 @@ void KMahjonggBackground::sizeChanged(int newW, int newH)
     }
     d->w = newW;
     d->h = newH;
+    d->imageCache.clear();
 }
 
-QString KMahjonggBackgroundPrivate::pixmapCacheNameFromElementId(const QString &elementid, short width, short height)
+QString KMahjonggBackgroundPrivate::pixmapCacheNameFromElementId(const QString &elementid, short width, short height) const
 {
     return name + elementid + QStringLiteral("W%1H%2").arg(width).arg(height);
 }
 
-QPixmap KMahjonggBackgroundPrivate::renderBG(short width, short height)
+QImage KMahjonggBackgroundPrivate::renderBG(short width, short height, qreal dpr) const
 {
-    QPixmap qiRend(width, height);
+    if (procedural.isValid()) {
+        return procedural.render(QSize(width, height), dpr);
+    }
+
+    QImage qiRend(width, height, QImage::Format_ARGB32_Premultiplied);
     qiRend.fill(Qt::transparent);
 
-    if (svg.isValid()) {
+    const KMahjonggDisplayList list = displayListFor(QSize(width, height));
+    if (!list.isNull()) {
+        QPainter p(&qiRend);
+        list.replay(&p, QRectF(0, 0, width, height));
+    } else if (svg.isValid()) {
         QPainter p(&qiRend);
         svg.render(&p);
     }
     return qiRend;
 }
 
+KMahjonggDisplayList KMahjonggBackgroundPrivate::displayListFor(QSize size) const
+{
+    // Tiled patterns are rendered once per scale, only stretched backgrounds again
+    // on every resize. Covers windows up to 4K, anything larger is rendered from the SVG.
+    const QSizeF recordedSize(4096, 4096);
+    if (isTiled || !svg.isValid() || QSizeF(size).boundedTo(recordedSize) != QSizeF(size)) {
+        return KMahjonggDisplayList();
+    }
+
+    const QMutexLocker locker(&displayListMutex);
+    if (!displayListRecorded) {
+        // stays null if recording fails, which is not retried
+        displayListRecorded = true;
+        const QRectF bounds(QPointF(), recordedSize);
+        displayList = KMahjonggDisplayList::record(bounds.size(), [this, &bounds](QPainter *painter) {
+            svg.render(painter, QString(), bounds);
+        });
+    }
+    return displayList;
+}
+
+void KMahjonggBackgroundPrivate::resetDisplayList()
+{
+    const QMutexLocker locker(&displayListMutex);
+
+    displayList = KMahjonggDisplayList();
+    displayListRecorded = false;
+}
+
+QSize KMahjonggBackgroundPrivate::patternSize(qreal dpr) const
+{
+    // rounded to whole device pixels, so repeated patterns meet without seams at fractional scales
+    return QSize(std::max(1, qRound(w * dpr)), std::max(1, qRound(h * dpr)));
+}
+
+QString KMahjonggBackgroundPrivate::textureCacheName(QSize patternSize) const
+{
+    // using raw size with cache id, as the rendering is done dpr-ignorant
+    const QString cacheName = pixmapCacheNameFromElementId(filename, patternSize.width(), patternSize.height());
+    return isTiled ? cacheName + QStringLiteral("T%1x%2").arg(textureSize.width()).arg(textureSize.height()) : cacheName;
+}
+
+QImage KMahjonggBackgroundPrivate::renderTexture(QSize patternSize, qreal dpr) const
+{
+    QImage pattern = renderBG(patternSize.width(), patternSize.height(), dpr);
+    const int columns = isTiled ? std::max(1, (textureSize.width() + patternSize.width() - 1) / patternSize.width()) : 1;
+    const int rows = isTiled ? std::max(1, (textureSize.height() + patternSize.height() - 1) / patternSize.height()) : 1;
+    if (columns == 1 && rows == 1) {
+        pattern.setDevicePixelRatio(dpr);
+        return pattern;
+    }
+
+    // repeated once here, so filling a large window needs far fewer brush repeats
+    QImage texture(patternSize.width() * columns, patternSize.height() * rows, QImage::Format_ARGB32_Premultiplied);
+    QPainter painter(&texture);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    for (int row = 0; row < rows; ++row) {
+        for (int column = 0; column < columns; ++column) {
+            painter.drawImage(QPoint(column * patternSize.width(), row * patternSize.height()), pattern);
+        }
+    }
+    painter.end();
+    texture.setDevicePixelRatio(dpr);
+    return texture;
+}
+
+QByteArray KMahjonggBackgroundPrivate::computeFileHash() const
+{
+    // the background is rendered as a whole, so there is just one element to compare
+    QFile file(svg.fileName());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(&file);
+    return hash.result();
+}
+
+QString KMahjonggBackground::graphicsSourcePath() const
+{
+    Q_D(const KMahjonggBackground);
+
+    return d->svg.fileName();
+}
+
+void KMahjonggBackground::startChangeTracking()
+{
+    Q_D(KMahjonggBackground);
+
+    d->fileHash = d->computeFileHash();
+}
+
+bool KMahjonggBackground::reloadIfChanged()
+{
+    Q_D(KMahjonggBackground);
+
+    if (d->isPlain || !d->isSVG) {
+        return false;
+    }
+    const QByteArray newHash = d->computeFileHash();
+    if (!newHash.isEmpty() && newHash == d->fileHash) {
+        return false;
+    }
+    d->fileHash = newHash;
+
+    d->svg.load(d->graphicspath);
+    d->resetDisplayList();
+    KMahjonggCachePrivate::instance()->removeContaining(KMahjonggCache::Backgrounds, d->name + d->filename);
+    d->imageCache.clear();
+    return true;
+}
+
 QBrush &KMahjonggBackground::getBackground()
 {
     Q_D(KMahjonggBackground);
 
     if (d->isPlain) {
         d->backgroundBrush = QBrush(QPixmap());
+    } else if (d->procedural.hasNativeBrush()) {
+        // drawn by QPainter directly, no pixmap needed at all
+        d->backgroundBrush = d->procedural.nativeBrush();
     } else {
-        const qreal dpr = qApp->devicePixelRatio();
-        const short width = d->w * dpr;
-        const short height = d->h * dpr;
-
-        // using raw pixmap size with cache id, as the rendering is done dpr-ignorant
-        const QString pixmapCacheName = d->pixmapCacheNameFromElementId(d->filename, width, height);
-        if (!QPixmapCache::find(pixmapCacheName, &d->backgroundPixmap)) {
-            d->backgroundPixmap = d->renderBG(width, height);
+        const qreal dpr = KMahjonggUtils::defaultDevicePixelRatio();
+        const QSize patternSize = d->patternSize(dpr);
+
+        const QString pixmapCacheName = d->textureCacheName(patternSize);
+        KMahjonggCachePrivate *cache = KMahjonggCachePrivate::instance();
+        if (!cache->find(KMahjonggCache::Backgrounds, pixmapCacheName, &d->backgroundPixmap)) {
+            cache->noteDemandRender();
+            d->backgroundPixmap = QPixmap::fromImage(d->renderTexture(patternSize, dpr));
             d->backgroundPixmap.setDevicePixelRatio(dpr);
-            QPixmapCache::insert(pixmapCacheName, d->backgroundPixmap);
+            cache->insert(KMahjonggCache::Backgrounds, pixmapCacheName, d->backgroundPixmap);
         }
         d->backgroundBrush = QBrush(d->backgroundPixmap);
     }
     return d->backgroundBrush;
 }
 
+bool KMahjonggBackground::isRendered() const
+{
+    Q_D(const KMahjonggBackground);
+
+    if (d->isPlain || d->procedural.hasNativeBrush()) {
+        return true;
+    }
+    const QSize patternSize = d->patternSize(KMahjonggUtils::defaultDevicePixelRatio());
+    QPixmap pixmap;
+    return KMahjonggCachePrivate::instance()->peek(KMahjonggCache::Backgrounds, d->textureCacheName(patternSize), &pixmap);
+}
+
+QImage KMahjonggBackground::backgroundImage(qreal devicePixelRatio, QImage::Format format) const
+{
+    Q_D(const KMahjonggBackground);
+
+    if (d->isPlain) {
+        return QImage();
+    }
+
+    const QSize patternSize = d->patternSize(devicePixelRatio);
+
+    const QString imageCacheName = d->textureCacheName(patternSize);
+    QImage image;
+    if (!d->imageCache.find(imageCacheName, &image)) {
+        KMahjonggCachePrivate::instance()->noteDemandRender();
+        // other threads keep reading the cache meanwhile
+        image = d->renderTexture(patternSize, devicePixelRatio);
+        d->imageCache.insert(imageCacheName, image);
+    }
+    return KMahjonggUtils::convertedToFormat(std::move(image), format);
+}
+
+void KMahjonggBackground::setTextureSize(QSize size)
+{
+    Q_D(KMahjonggBackground);
+
+    if (d->textureSize == size) {
+        return;
+    }
+    d->textureSize = size;
+    if (d->isTiled) {
+        d->imageCache.clear();
+    }
+}
+
+QSize KMahjonggBackground::textureSize() const
+{
+    Q_D(const KMahjonggBackground);
+
+    return d->textureSize;
+}
+
 QString KMahjonggBackground::path() const
 {
     Q_D(const KMahjonggBackground);
@@ -11,6 +11,8 @@
 // Qt
 #include <QtClassHelperMacros> // Q_DECLARE_PRIVATE
 #include <QBrush>
+#include <QImage>
+#include <QString>
 // Std
 #include <memory>
 
@@ -23,6 +25,14 @@ class KMahjonggBackgroundPrivate;
  * @class KMahjonggBackground kmahjonggbackground.h <KMahjonggBackground>
  *
  * A background
+ *
+ * Backgrounds are SVG files, a plain colour (Plain=1), or generated from a
+ * few parameters (Type=Procedural), like gradients, stripes or noise.
+ *
+ * getBackground() is to be used on the GUI thread only.
+ * backgroundImage() may be called from any thread concurrently,
+ * as long as the background is not loaded or resized at the same time.
+ * It also works without a QGuiApplication, e.g. for headless batch rendering.
  */
 class LIBKMAHJONGG_EXPORT KMahjonggBackground
 {
@@ -35,6 +45,15 @@ public:
     bool loadGraphics();
     void sizeChanged(int newW, int newH);
     QBrush &getBackground();
+    QImage backgroundImage(qreal devicePixelRatio, QImage::Format format = QImage::Format_ARGB32_Premultiplied) const;
+    /**
+     * Sets the minimal size in device pixels of the texture which the pattern of
+     * tiled backgrounds gets repeated into, default 512x512.
+     * The texture is made of whole patterns, each aligned to device pixels.
+     * An empty size disables the repeating.
+     */
+    void setTextureSize(QSize size);
+    QSize textureSize() const;
     QString path() const;
 
     QString name() const;
@@ -49,6 +68,17 @@ public:
     bool isPlain() const;
 
 private:
+    // for KMahjonggThemeWatcher
+    QString graphicsSourcePath() const;
+    void startChangeTracking();
+    bool reloadIfChanged();
+
+    // for KMahjonggRenderQueue, whether getBackground() would return without rendering
+    bool isRendered() const;
+
+private:
+    friend class KMahjonggRenderQueue;
+    friend class KMahjonggThemeWatcher;
     std::unique_ptr<KMahjonggBackgroundPrivate> const d_ptr;
     Q_DECLARE_PRIVATE(KMahjonggBackground)
     Q_DISABLE_COPY(KMahjonggBackground)
@@ -8,7 +8,6 @@
 #include "kmahjonggbackgroundselector.h"
 
 // Qt
-#include <QDir>
 #include <QPainter>
 
 // KF
@@ -17,6 +16,7 @@
 
 // LibKMahjongg
 #include "kmahjonggbackground.h"
+#include "kmahjonggthememodel_p.h"
 
 KMahjonggBackgroundSelector::KMahjonggBackgroundSelector(QWidget *parent, KConfigSkeleton *aconfig)
     : QWidget(parent)
@@ -25,10 +25,7 @@ KMahjonggBackgroundSelector::KMahjonggBackgroundSelector(QWidget *parent, KConfi
     setupData(aconfig);
 }
 
-KMahjonggBackgroundSelector::~KMahjonggBackgroundSelector()
-{
-    qDeleteAll(backgroundMap);
-}
+KMahjonggBackgroundSelector::~KMahjonggBackgroundSelector() = default;
 
 void KMahjonggBackgroundSelector::setupData(KConfigSkeleton *aconfig)
 {
@@ -40,78 +37,52 @@ void KMahjonggBackgroundSelector::setupData(KConfigSkeleton *aconfig)
     // The lineEdit widget holds our bg path, but the user does not manipulate it directly
     kcfg_Background->hide();
 
-    KMahjonggBackground bg;
-
-    // Now get our backgrounds into a list
-    QStringList bgsAvailable;
-    const QStringList dirs =
-        QStandardPaths::locateAll(QStandardPaths::GenericDataLocation, QStringLiteral("kmahjongglib/backgrounds"), QStandardPaths::LocateDirectory);
-    for (const QString &dir : dirs) {
-        const QStringList fileNames = QDir(dir).entryList({QStringLiteral("*.desktop")});
-        bgsAvailable.reserve(bgsAvailable.size() + fileNames.size());
-        for (const QString &file : fileNames) {
-            bgsAvailable.append(dir + QLatin1Char('/') + file);
-        }
-    }
-
+    // Backgrounds are only read when their row gets shown or selected
+    backgroundModel = new KMahjonggThemeModel(KMahjonggThemeModel::Backgrounds, this);
     const qreal dpr = qApp->devicePixelRatio();
-    const QSize previewSize = backgroundPreview->size() * dpr;
-
-    int numvalidentries = 0;
-    for (const QString &bgpath : std::as_const(bgsAvailable)) {
-        auto *abg = new KMahjonggBackground();
-        if (abg->load(bgpath, previewSize.width(), previewSize.height())) {
-            const QString name = abg->name();
-            backgroundMap.insert(name, abg);
-            backgroundList->addItem(name);
-            // Find if this is our currently configured background
-            if (bgpath == initialGroup) {
-                // Select current entry
-                backgroundList->setCurrentRow(numvalidentries);
-                backgroundChanged();
-            }
-            ++numvalidentries;
-        } else {
-            delete abg;
-        }
-    }
+    backgroundModel->setBackgroundSize(backgroundPreview->size() * dpr);
+    backgroundList->setModel(backgroundModel);
+
+    connect(backgroundList->selectionModel(), &QItemSelectionModel::currentChanged, this, &KMahjonggBackgroundSelector::backgroundChanged);
 
-    connect(backgroundList, &QListWidget::currentItemChanged, this, &KMahjonggBackgroundSelector::backgroundChanged);
+    // Find if we have our currently configured background
+    const int initialRow = backgroundModel->rowForPath(initialGroup);
+    if (initialRow >= 0) {
+        // Select current entry
+        backgroundList->setCurrentIndex(backgroundModel->index(initialRow));
+    }
 }
 
 void KMahjonggBackgroundSelector::backgroundChanged()
 {
-    KMahjonggBackground *selBG = backgroundMap.value(backgroundList->currentItem()->text());
+    const QModelIndex current = backgroundList->currentIndex();
     // Sanity checkings. Should not happen.
-    if (selBG == nullptr) {
+    if (!current.isValid()) {
         return;
     }
-    if (selBG->path() == kcfg_Background->text()) {
+    const QString path = current.data(KMahjonggThemeModel::PathRole).toString();
+    if (path == kcfg_Background->text()) {
         return;
     }
 
-    kcfg_Background->setText(selBG->path());
-    backgroundAuthor->setText(selBG->authorName());
-    backgroundContact->setText(selBG->authorEmailAddress());
-    backgroundDescription->setText(selBG->description());
-    backgroundDescription->setText(selBG->description());
-    backgroundVersion->setText(selBG->version());
-    QString website = selBG->website();
+    kcfg_Background->setText(path);
+    backgroundAuthor->setText(current.data(KMahjonggThemeModel::AuthorRole).toString());
+    backgroundContact->setText(current.data(KMahjonggThemeModel::AuthorEmailRole).toString());
+    backgroundDescription->setText(current.data(KMahjonggThemeModel::DescriptionRole).toString());
+    backgroundVersion->setText(current.data(KMahjonggThemeModel::VersionRole).toString());
+    QString website = current.data(KMahjonggThemeModel::WebsiteRole).toString();
     if (!website.isEmpty()) {
         website = QLatin1String("<a href=\"") + website + QLatin1String("\">") + website + QLatin1String("</a>");
     }
     backgroundWebsite->setText(website);
-    backgroundCopyright->setText(selBG->copyrightText());
-    const QString licenseName = KAboutLicense::byKeyword(selBG->license()).name(KAboutLicense::FullName);
+    backgroundCopyright->setText(current.data(KMahjonggThemeModel::CopyrightRole).toString());
+    const QString licenseName = KAboutLicense::byKeyword(current.data(KMahjonggThemeModel::LicenseRole).toString()).name(KAboutLicense::FullName);
     backgroundLicense->setText(licenseName);
 
-    if (selBG->isPlain()) {
-        backgroundPreview->setPixmap(QPixmap());
-        return;
-    }
-
     // Make sure SVG is loaded when graphics is selected
-    if (!selBG->loadGraphics()) {
+    KMahjonggBackground *selBG = backgroundModel->background(current.row());
+    if (selBG == nullptr || selBG->isPlain()) {
+        backgroundPreview->setPixmap(QPixmap());
         return;
     }
 
@@ -7,16 +7,13 @@
 #ifndef KMAHJONGGBACKGROUNDSELECTOR_H
 #define KMAHJONGGBACKGROUNDSELECTOR_H
 
-// Qt
-#include <QHash>
-
 // KF
 #include <KConfigSkeleton>
 
 // LibKMahjongg
 #include "ui_kmahjonggbackgroundselector.h"
 
-class KMahjonggBackground;
+class KMahjonggThemeModel;
 
 class KMahjonggBackgroundSelector : public QWidget, private Ui::KMahjonggBackgroundSelector
 {
@@ -32,7 +29,7 @@ public Q_SLOTS:
     void backgroundChanged();
 
 private:
-    QHash<QString, KMahjonggBackground *> backgroundMap;
+    KMahjonggThemeModel *backgroundModel = nullptr;
 };
 
 #endif // KMAHJONGGBACKGROUNDSELECTOR_H
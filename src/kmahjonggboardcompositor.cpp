@@ -0,0 +1,362 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+// own
+#include "kmahjonggboardcompositor.h"
+
+// Qt
+#include <QHash>
+#include <QPainter>
+// Std
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+// LibKMahjongg
+#include "kmahjonggboardgeometry_p.h"
+#include "kmahjonggtileset.h"
+#include "kmahjonggvisibilityindex.h"
+
+namespace
+{
+struct BoardTile {
+    KMahjonggTilePlacement placement;
+    bool present = true;
+};
+}
+
+class KMahjonggBoardCompositorPrivate
+{
+public:
+    explicit KMahjonggBoardCompositorPrivate(const KMahjonggTileset *tileset)
+        : tileset(tileset)
+        , visibility(tileset)
+    {
+    }
+
+    bool drawsBefore(int id, int otherId) const;
+    void sortDrawOrder();
+    void markDirty(int id);
+    void markAllDirty();
+    void clearImages();
+    const QImage &bodyImage(bool selected);
+    const QImage &faceImage(int face);
+    void paintRect(QPainter &painter, const QRect &rect);
+
+public:
+    const KMahjonggTileset *tileset;
+
+    std::vector<BoardTile> tiles;
+    std::vector<int> drawOrder; // ids of present tiles, bottom-most first
+    // hidden tiles are neither drawn nor are their faces rendered
+    KMahjonggVisibilityIndex visibility;
+
+    QBrush background;
+    qreal dpr = 1.0;
+
+    KMahjonggBoardGeometry geometry; // the one used for the current board image
+    QImage board;
+    QRegion dirty;
+    bool fullRecompose = true;
+
+    // local copies, to save the lookups in the tileset's cache for each drawn tile
+    QImage bodyImages[2];
+    QHash<int, QImage> faceImages;
+};
+
+bool KMahjonggBoardCompositorPrivate::drawsBefore(int id, int otherId) const
+{
+    const KMahjonggTilePlacement &tile = tiles[id].placement;
+    const KMahjonggTilePlacement &other = tiles[otherId].placement;
+    if (geometry.drawsBefore(tile, other)) {
+        return true;
+    }
+    if (geometry.drawsBefore(other, tile)) {
+        return false;
+    }
+    return id < otherId;
+}
+
+void KMahjonggBoardCompositorPrivate::sortDrawOrder()
+{
+    std::sort(drawOrder.begin(), drawOrder.end(), [this](int id, int otherId) {
+        return drawsBefore(id, otherId);
+    });
+}
+
+void KMahjonggBoardCompositorPrivate::markDirty(int id)
+{
+    KMahjonggBoardGeometry currentGeometry = geometry;
+    currentGeometry.metrics = KMahjonggBoardMetrics::fromTileset(tileset);
+    dirty += currentGeometry.tileRect(tiles[id].placement);
+}
+
+void KMahjonggBoardCompositorPrivate::markAllDirty()
+{
+    fullRecompose = true;
+}
+
+void KMahjonggBoardCompositorPrivate::clearImages()
+{
+    bodyImages[0] = QImage();
+    bodyImages[1] = QImage();
+    faceImages.clear();
+}
+
+const QImage &KMahjonggBoardCompositorPrivate::bodyImage(bool selected)
+{
+    QImage &image = bodyImages[selected ? 1 : 0];
+    if (image.isNull()) {
+        const int variant = geometry.variant;
+        image = selected ? tileset->selectedTileImage(variant, dpr) : tileset->unselectedTileImage(variant, dpr);
+    }
+    return image;
+}
+
+const QImage &KMahjonggBoardCompositorPrivate::faceImage(int face)
+{
+    auto it = faceImages.find(face);
+    if (it == faceImages.end()) {
+        it = faceImages.insert(face, tileset->tilefaceImage(face, dpr));
+    }
+    return *it;
+}
+
+void KMahjonggBoardCompositorPrivate::paintRect(QPainter &painter, const QRect &rect)
+{
+    painter.setClipRect(rect);
+
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    if (background.style() == Qt::NoBrush) {
+        painter.fillRect(rect, Qt::transparent);
+    } else {
+        painter.fillRect(rect, background);
+    }
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+
+    for (const int id : std::as_const(drawOrder)) {
+        const KMahjonggTilePlacement &tile = tiles[id].placement;
+        const QRect bodyRect = geometry.tileRect(tile);
+        if (!bodyRect.intersects(rect) || visibility.isHidden(id)) {
+            continue;
+        }
+
+        painter.drawImage(bodyRect.topLeft(), bodyImage(tile.selected));
+        if (tile.face < 0) {
+            continue;
+        }
+        const QImage &face = faceImage(tile.face);
+        const QPoint faceOffset = geometry.faceOffset(face.deviceIndependentSize().toSize());
+        painter.drawImage(bodyRect.topLeft() + faceOffset, face);
+    }
+}
+
+// ---------------------------------------------------------
+
+KMahjonggBoardCompositor::KMahjonggBoardCompositor(const KMahjonggTileset *tileset)
+    : d_ptr(new KMahjonggBoardCompositorPrivate(tileset))
+{
+}
+
+KMahjonggBoardCompositor::~KMahjonggBoardCompositor() = default;
+
+void KMahjonggBoardCompositor::setTileVariant(int variant)
+{
+    Q_D(KMahjonggBoardCompositor);
+
+    if (variant == d->geometry.variant || variant < 0 || variant > 3) {
+        return;
+    }
+    d->geometry.variant = variant;
+    d->visibility.setTileVariant(variant);
+    d->sortDrawOrder();
+    d->clearImages();
+    d->markAllDirty();
+}
+
+int KMahjonggBoardCompositor::tileVariant() const
+{
+    Q_D(const KMahjonggBoardCompositor);
+
+    return d->geometry.variant;
+}
+
+void KMahjonggBoardCompositor::setDevicePixelRatio(qreal devicePixelRatio)
+{
+    Q_D(KMahjonggBoardCompositor);
+
+    if (devicePixelRatio == d->dpr) {
+        return;
+    }
+    d->dpr = devicePixelRatio;
+    d->clearImages();
+    d->markAllDirty();
+}
+
+qreal KMahjonggBoardCompositor::devicePixelRatio() const
+{
+    Q_D(const KMahjonggBoardCompositor);
+
+    return d->dpr;
+}
+
+void KMahjonggBoardCompositor::setBackground(const QBrush &brush)
+{
+    Q_D(KMahjonggBoardCompositor);
+
+    d->background = brush;
+    d->markAllDirty();
+}
+
+void KMahjonggBoardCompositor::setBoardSize(int columns, int rows, int levels)
+{
+    Q_D(KMahjonggBoardCompositor);
+
+    d->geometry.columns = columns;
+    d->geometry.rows = rows;
+    d->geometry.levels = std::max(1, levels);
+    d->visibility.setBoardSize(columns, rows, levels);
+    d->markAllDirty();
+}
+
+QSize KMahjonggBoardCompositor::size() const
+{
+    Q_D(const KMahjonggBoardCompositor);
+
+    KMahjonggBoardGeometry geometry = d->geometry;
+    geometry.metrics = KMahjonggBoardMetrics::fromTileset(d->tileset);
+    return geometry.boardSize();
+}
+
+void KMahjonggBoardCompositor::setTiles(const QList<KMahjonggTilePlacement> &tiles)
+{
+    Q_D(KMahjonggBoardCompositor);
+
+    d->tiles.clear();
+    d->tiles.reserve(tiles.size());
+    d->drawOrder.clear();
+    d->drawOrder.reserve(tiles.size());
+    for (const KMahjonggTilePlacement &tile : tiles) {
+        d->drawOrder.push_back(static_cast<int>(d->tiles.size()));
+        d->tiles.push_back({tile, true});
+    }
+    d->sortDrawOrder();
+    d->visibility.setTiles(tiles);
+    d->markAllDirty();
+}
+
+int KMahjonggBoardCompositor::addTile(const KMahjonggTilePlacement &tile)
+{
+    Q_D(KMahjonggBoardCompositor);
+
+    const int id = static_cast<int>(d->tiles.size());
+    d->tiles.push_back({tile, true});
+    const auto pos = std::upper_bound(d->drawOrder.begin(), d->drawOrder.end(), id, [d](int a, int b) {
+        return d->drawsBefore(a, b);
+    });
+    d->drawOrder.insert(pos, id);
+    d->visibility.addTile(tile);
+    d->markDirty(id);
+    return id;
+}
+
+void KMahjonggBoardCompositor::removeTile(int id)
+{
+    Q_D(KMahjonggBoardCompositor);
+
+    if (!hasTile(id)) {
+        return;
+    }
+    d->tiles[id].present = false;
+    d->drawOrder.erase(std::find(d->drawOrder.begin(), d->drawOrder.end(), id));
+    d->visibility.removeTile(id);
+    d->markDirty(id);
+}
+
+void KMahjonggBoardCompositor::setTileSelected(int id, bool selected)
+{
+    Q_D(KMahjonggBoardCompositor);
+
+    if (!hasTile(id) || d->tiles[id].placement.selected == selected) {
+        return;
+    }
+    d->tiles[id].placement.selected = selected;
+    d->markDirty(id);
+}
+
+KMahjonggTilePlacement KMahjonggBoardCompositor::tile(int id) const
+{
+    Q_D(const KMahjonggBoardCompositor);
+
+    if (id < 0 || id >= static_cast<int>(d->tiles.size())) {
+        return KMahjonggTilePlacement();
+    }
+    return d->tiles[id].placement;
+}
+
+bool KMahjonggBoardCompositor::hasTile(int id) const
+{
+    Q_D(const KMahjonggBoardCompositor);
+
+    return id >= 0 && id < static_cast<int>(d->tiles.size()) && d->tiles[id].present;
+}
+
+QRect KMahjonggBoardCompositor::tileRect(const KMahjonggTilePlacement &tile) const
+{
+    Q_D(const KMahjonggBoardCompositor);
+
+    KMahjonggBoardGeometry geometry = d->geometry;
+    geometry.metrics = KMahjonggBoardMetrics::fromTileset(d->tileset);
+    return geometry.tileRect(tile);
+}
+
+void KMahjonggBoardCompositor::invalidate()
+{
+    Q_D(KMahjonggBoardCompositor);
+
+    d->markAllDirty();
+}
+
+QRegion KMahjonggBoardCompositor::compose()
+{
+    Q_D(KMahjonggBoardCompositor);
+
+    const KMahjonggBoardMetrics metrics = KMahjonggBoardMetrics::fromTileset(d->tileset);
+    if (!(metrics == d->geometry.metrics)) {
+        // the tileset got resized
+        d->geometry.metrics = metrics;
+        d->clearImages();
+        d->fullRecompose = true;
+    }
+
+    const QSize size = d->geometry.boardSize();
+    if (d->fullRecompose) {
+        d->board = QImage(size * d->dpr, QImage::Format_ARGB32_Premultiplied);
+        d->board.setDevicePixelRatio(d->dpr);
+        d->dirty = QRect(QPoint(0, 0), size);
+        d->fullRecompose = false;
+    }
+
+    if (d->dirty.isEmpty() || d->board.isNull()) {
+        return QRegion();
+    }
+
+    const QRegion updated = d->dirty & QRect(QPoint(0, 0), size);
+    d->dirty = QRegion();
+
+    QPainter painter(&d->board);
+    for (const QRect &rect : updated) {
+        d->paintRect(painter, rect);
+    }
+    return updated;
+}
+
+QImage KMahjonggBoardCompositor::image() const
+{
+    Q_D(const KMahjonggBoardCompositor);
+
+    return d->board;
+}
@@ -0,0 +1,107 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef KMAHJONGGBOARDCOMPOSITOR_H
+#define KMAHJONGGBOARDCOMPOSITOR_H
+
+// Qt
+#include <QtClassHelperMacros> // Q_DECLARE_PRIVATE
+#include <QBrush>
+#include <QImage>
+#include <QList>
+#include <QRect>
+#include <QRegion>
+// Std
+#include <memory>
+
+// LibKMahjongg
+#include <libkmahjongg_export.h>
+
+class KMahjonggTileset;
+class KMahjonggBoardCompositorPrivate;
+
+/**
+ * Position of a tile on a board.
+ *
+ * @p x and @p y are in quarter cells, i.e. in units of KMahjonggTileset::qWidth()
+ * and KMahjonggTileset::qHeight(), so a tile covers 2x2 of them.
+ */
+struct KMahjonggTilePlacement {
+    int x = 0;
+    int y = 0;
+    int level = 0;
+    int face = -1; ///< as passed to KMahjonggTileset::tileface(), or -1 for no face
+    bool selected = false;
+};
+
+/**
+ * @class KMahjonggBoardCompositor kmahjonggboardcompositor.h <KMahjonggBoardCompositor>
+ *
+ * Keeps a composed image of a board of stacked tiles.
+ *
+ * Changes to single tiles only recompose the area covered by those tiles,
+ * so e.g. removing a pair costs two tile-sized repaints instead of a full redraw.
+ * Tiles completely covered by tiles above them are skipped, see KMahjonggVisibilityIndex.
+ * The compositor only uses the QImage API of KMahjonggTileset, so it works headless
+ * and can be used from a worker thread.
+ */
+class LIBKMAHJONGG_EXPORT KMahjonggBoardCompositor
+{
+public:
+    explicit KMahjonggBoardCompositor(const KMahjonggTileset *tileset);
+    ~KMahjonggBoardCompositor();
+
+    /**
+     * Sets the tile body to use, as passed to KMahjonggTileset::unselectedTile().
+     * This also defines the direction in which higher levels are shifted.
+     */
+    void setTileVariant(int variant);
+    int tileVariant() const;
+
+    void setDevicePixelRatio(qreal devicePixelRatio);
+    qreal devicePixelRatio() const;
+
+    void setBackground(const QBrush &brush);
+
+    /**
+     * Sets the size of the board, in quarter cells and levels.
+     */
+    void setBoardSize(int columns, int rows, int levels);
+    /// size of the composed board in logical pixels
+    QSize size() const;
+
+    void setTiles(const QList<KMahjonggTilePlacement> &tiles);
+    /// @return the id of the added tile
+    int addTile(const KMahjonggTilePlacement &tile);
+    void removeTile(int id);
+    void setTileSelected(int id, bool selected);
+    KMahjonggTilePlacement tile(int id) const;
+    bool hasTile(int id) const;
+
+    /// area covered by the tile body, in logical pixels
+    QRect tileRect(const KMahjonggTilePlacement &tile) const;
+
+    /**
+     * Recomposes everything, e.g. after the tileset has been resized.
+     * This is also done automatically if the tile size changed on the next compose().
+     */
+    void invalidate();
+
+    /**
+     * Recomposes the areas touched since the last call.
+     * @return the recomposed region in logical pixels, to be updated on screen
+     */
+    QRegion compose();
+    /// the composed board, call compose() before to have it up-to-date
+    QImage image() const;
+
+private:
+    std::unique_ptr<KMahjonggBoardCompositorPrivate> const d_ptr;
+    Q_DECLARE_PRIVATE(KMahjonggBoardCompositor)
+    Q_DISABLE_COPY(KMahjonggBoardCompositor)
+};
+
+#endif // KMAHJONGGBOARDCOMPOSITOR_H
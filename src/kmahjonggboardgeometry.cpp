@@ -0,0 +1,84 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+// own
+#include "kmahjonggboardgeometry_p.h"
+
+// LibKMahjongg
+#include "kmahjonggtileset.h"
+
+KMahjonggBoardMetrics KMahjonggBoardMetrics::fromTileset(const KMahjonggTileset *tileset)
+{
+    KMahjonggBoardMetrics metrics;
+    metrics.w = tileset->width();
+    metrics.h = tileset->height();
+    const QSize faceSize = tileset->faceSize();
+    metrics.fw = faceSize.width();
+    metrics.fh = faceSize.height();
+    metrics.qw = tileset->qWidth();
+    metrics.qh = tileset->qHeight();
+    metrics.lvloffx = tileset->levelOffsetX();
+    metrics.lvloffy = tileset->levelOffsetY();
+    return metrics;
+}
+
+QPoint KMahjonggBoardGeometry::levelShift(int level) const
+{
+    // higher levels are shifted away from the 3D sides,
+    // the board origin is chosen so that the shifted tiles stay inside
+    const int levelsX = sidesLeft() ? level : (levels - 1 - level);
+    const int levelsY = sidesTop() ? level : (levels - 1 - level);
+    return QPoint(levelsX * metrics.lvloffx, levelsY * metrics.lvloffy);
+}
+
+QRect KMahjonggBoardGeometry::tileRect(const KMahjonggTilePlacement &tile) const
+{
+    const QPoint shift = levelShift(tile.level);
+    return QRect(tile.x * metrics.qw + shift.x(), //
+                 tile.y * metrics.qh + shift.y(),
+                 metrics.w,
+                 metrics.h);
+}
+
+QRect KMahjonggBoardGeometry::opaqueRect(const KMahjonggTilePlacement &tile) const
+{
+    // anything beyond is shadow or anti-aliased border, which might be translucent
+    const int width = metrics.fw + metrics.lvloffx;
+    const int height = metrics.fh + metrics.lvloffy;
+    const QRect body = tileRect(tile);
+    const int x = sidesLeft() ? (body.right() + 1 - width) : body.left();
+    const int y = sidesTop() ? (body.bottom() + 1 - height) : body.top();
+    return QRect(x, y, width, height);
+}
+
+QPoint KMahjonggBoardGeometry::faceOffset(QSize faceSize) const
+{
+    // the face sits in the corner opposite to the 3D sides
+    return QPoint(sidesLeft() ? (metrics.w - faceSize.width()) : 0, //
+                  sidesTop() ? (metrics.h - faceSize.height()) : 0);
+}
+
+QSize KMahjonggBoardGeometry::boardSize() const
+{
+    // the last tile in a row or column adds its 3D sides
+    return QSize(columns * metrics.qw + (metrics.w - 2 * metrics.qw) + (levels - 1) * metrics.lvloffx,
+                 rows * metrics.qh + (metrics.h - 2 * metrics.qh) + (levels - 1) * metrics.lvloffy);
+}
+
+bool KMahjonggBoardGeometry::drawsBefore(const KMahjonggTilePlacement &tile, const KMahjonggTilePlacement &other) const
+{
+    // 3D sides are covered by the neighbour tiles, so draw tiles from the sides away
+    if (tile.level != other.level) {
+        return tile.level < other.level;
+    }
+    if (tile.y != other.y) {
+        return sidesTop() ? (tile.y > other.y) : (tile.y < other.y);
+    }
+    if (tile.x != other.x) {
+        return sidesLeft() ? (tile.x > other.x) : (tile.x < other.x);
+    }
+    return false;
+}
@@ -0,0 +1,76 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef KMAHJONGGBOARDGEOMETRY_P_H
+#define KMAHJONGGBOARDGEOMETRY_P_H
+
+// Qt
+#include <QRect>
+#include <QSize>
+
+// LibKMahjongg
+#include "kmahjonggboardcompositor.h"
+
+class KMahjonggTileset;
+
+class KMahjonggBoardMetrics
+{
+public:
+    static KMahjonggBoardMetrics fromTileset(const KMahjonggTileset *tileset);
+
+    bool operator==(const KMahjonggBoardMetrics &other) const
+    {
+        return w == other.w && h == other.h && fw == other.fw && fh == other.fh && qw == other.qw && qh == other.qh && lvloffx == other.lvloffx
+            && lvloffy == other.lvloffy;
+    }
+
+public:
+    short w = 0;
+    short h = 0;
+    short fw = 0;
+    short fh = 0;
+    short qw = 0;
+    short qh = 0;
+    short lvloffx = 0;
+    short lvloffy = 0;
+};
+
+/**
+ * Pixel layout of a board of stacked tiles, shared by the compositor and the board indexes.
+ */
+class KMahjonggBoardGeometry
+{
+public:
+    // the tile bodies TILE_1..4 differ in which sides show 3D borders
+    bool sidesLeft() const
+    {
+        return variant == 0 || variant == 3;
+    }
+    bool sidesTop() const
+    {
+        return variant == 2 || variant == 3;
+    }
+
+    /// offset of all tiles on @p level
+    QPoint levelShift(int level) const;
+    /// area covered by the tile body
+    QRect tileRect(const KMahjonggTilePlacement &tile) const;
+    /// area which is surely covered by the tile, i.e. the face and one level offset of 3D sides
+    QRect opaqueRect(const KMahjonggTilePlacement &tile) const;
+    QPoint faceOffset(QSize faceSize) const;
+    QSize boardSize() const;
+    /// whether @p tile needs to be drawn before @p other when painting bottom-up
+    bool drawsBefore(const KMahjonggTilePlacement &tile, const KMahjonggTilePlacement &other) const;
+
+public:
+    KMahjonggBoardMetrics metrics;
+    int variant = 0;
+    int columns = 0;
+    int rows = 0;
+    int levels = 1;
+};
+
+#endif // KMAHJONGGBOARDGEOMETRY_P_H
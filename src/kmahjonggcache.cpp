@@ -0,0 +1,380 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+// own
+#include "kmahjonggcache.h"
+#include "kmahjonggcache_p.h"
+
+// Qt
+#include <QCoreApplication>
+// Std
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+// fastest zlib level, restoring is what matters and is fast for any level
+constexpr int coldCompressionLevel = 1;
+
+// cost of a pixmap in KiB, like QPixmapCache calculates it
+int pixmapCost(const QPixmap &pixmap)
+{
+    const qint64 bytes = static_cast<qint64>(pixmap.width()) * pixmap.height() * pixmap.depth() / 8;
+    return std::max(1, static_cast<int>(bytes / 1024));
+}
+
+int dataCost(const QByteArray &data)
+{
+    return std::max(1, static_cast<int>(data.size() / 1024));
+}
+
+int totalCost(const std::array<KMahjonggCachePartition, 3> &partitions)
+{
+    int cost = 0;
+    for (const KMahjonggCachePartition &partition : partitions) {
+        cost += partition.statistics.cost;
+    }
+    return cost;
+}
+}
+
+Q_GLOBAL_STATIC(KMahjonggCachePrivate, s_cache)
+
+bool KMahjonggCachePartition::find(const QString &key, QPixmap *pixmap)
+{
+    const auto it = index.constFind(key);
+    if (it == index.constEnd()) {
+        if (restore(key, pixmap)) {
+            ++statistics.coldHits;
+            return true;
+        }
+        ++statistics.misses;
+        return false;
+    }
+
+    // mark as most recently used
+    entries.splice(entries.begin(), entries, *it);
+    *pixmap = (*it)->pixmap;
+    ++statistics.hits;
+    return true;
+}
+
+bool KMahjonggCachePartition::peek(const QString &key, QPixmap *pixmap) const
+{
+    const auto it = index.constFind(key);
+    if (it == index.constEnd()) {
+        return false;
+    }
+    *pixmap = (*it)->pixmap;
+    return true;
+}
+
+bool KMahjonggCachePartition::insert(const QString &key, const QPixmap &pixmap)
+{
+    const int cost = pixmapCost(pixmap);
+    // like QPixmapCache, do not let a single pixmap flush the whole partition
+    if (cost > statistics.budget) {
+        return false;
+    }
+
+    const auto it = index.find(key);
+    if (it != index.end()) {
+        statistics.cost -= (*it)->cost;
+        entries.erase(*it);
+        index.erase(it);
+    }
+    removeCold(key);
+
+    add(key, pixmap, cost);
+    ++statistics.insertions;
+    return true;
+}
+
+void KMahjonggCachePartition::add(const QString &key, const QPixmap &pixmap, int cost)
+{
+    entries.push_front({key, pixmap, cost});
+    index.insert(key, entries.begin());
+    statistics.cost += cost;
+
+    trim(statistics.budget);
+}
+
+void KMahjonggCachePartition::trim(int maxCost)
+{
+    while (statistics.cost > maxCost && !entries.empty()) {
+        const Entry &entry = entries.back();
+        demote(entry);
+        statistics.cost -= entry.cost;
+        index.remove(entry.key);
+        entries.pop_back();
+        ++statistics.evictions;
+    }
+    statistics.entryCount = index.size();
+}
+
+void KMahjonggCachePartition::demote(const Entry &entry)
+{
+    if (statistics.coldBudget <= 0) {
+        return;
+    }
+
+    const QImage image = entry.pixmap.toImage();
+    const QByteArray data = qCompress(image.constBits(), image.sizeInBytes(), coldCompressionLevel);
+    const int cost = dataCost(data);
+    // noise-like content does not compress, keeping it would only waste the budget
+    if (data.isEmpty() || cost >= entry.cost || cost > statistics.coldBudget) {
+        return;
+    }
+
+    coldEntries.push_front({entry.key, data, image.size(), image.format(), entry.pixmap.devicePixelRatio(), cost});
+    coldIndex.insert(entry.key, coldEntries.begin());
+    statistics.coldCost += cost;
+    trimCold(statistics.coldBudget);
+}
+
+bool KMahjonggCachePartition::restore(const QString &key, QPixmap *pixmap)
+{
+    const auto it = coldIndex.constFind(key);
+    if (it == coldIndex.constEnd()) {
+        return false;
+    }
+
+    const ColdEntry &entry = **it;
+    const QByteArray pixels = qUncompress(entry.data);
+    QImage image(entry.size, entry.format);
+    if (image.isNull() || pixels.size() != image.sizeInBytes()) {
+        // useless
+        removeCold(key);
+        return false;
+    }
+    std::memcpy(image.bits(), pixels.constData(), pixels.size());
+    image.setDevicePixelRatio(entry.dpr);
+    *pixmap = QPixmap::fromImage(std::move(image));
+
+    // as in insert(), e.g. after the budget was lowered, so keep it cold
+    // instead of having trim() push it straight out and compress it again
+    const int cost = pixmapCost(*pixmap);
+    if (cost > statistics.budget) {
+        return true;
+    }
+
+    // back in the hot tier
+    removeCold(key);
+    add(key, *pixmap, cost);
+    return true;
+}
+
+void KMahjonggCachePartition::removeCold(const QString &key)
+{
+    const auto it = coldIndex.find(key);
+    if (it == coldIndex.end()) {
+        return;
+    }
+    statistics.coldCost -= (*it)->cost;
+    coldEntries.erase(*it);
+    coldIndex.erase(it);
+    statistics.coldEntryCount = coldIndex.size();
+}
+
+void KMahjonggCachePartition::trimCold(int maxCost)
+{
+    while (statistics.coldCost > maxCost && !coldEntries.empty()) {
+        const ColdEntry &entry = coldEntries.back();
+        statistics.coldCost -= entry.cost;
+        coldIndex.remove(entry.key);
+        coldEntries.pop_back();
+    }
+    statistics.coldEntryCount = coldIndex.size();
+}
+
+void KMahjonggCachePartition::clear()
+{
+    entries.clear();
+    index.clear();
+    coldEntries.clear();
+    coldIndex.clear();
+    statistics.cost = 0;
+    statistics.entryCount = 0;
+    statistics.coldCost = 0;
+    statistics.coldEntryCount = 0;
+}
+
+void KMahjonggCachePartition::removeContaining(const QString &keyPart)
+{
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (it->key.contains(keyPart)) {
+            statistics.cost -= it->cost;
+            index.remove(it->key);
+            it = entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    statistics.entryCount = index.size();
+
+    for (auto it = coldEntries.begin(); it != coldEntries.end();) {
+        if (it->key.contains(keyPart)) {
+            statistics.coldCost -= it->cost;
+            coldIndex.remove(it->key);
+            it = coldEntries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    statistics.coldEntryCount = coldIndex.size();
+}
+
+KMahjonggCachePrivate::KMahjonggCachePrivate()
+{
+    clock.start();
+
+    // tiles are needed for every frame, so they get the higher priorities
+    KMahjonggCachePartition &bodies = partitions[KMahjonggCache::TileBodies];
+    bodies.statistics.budget = 16 * 1024;
+    bodies.statistics.coldBudget = 4 * 1024;
+    bodies.priority = 20;
+    KMahjonggCachePartition &faces = partitions[KMahjonggCache::TileFaces];
+    faces.statistics.budget = 32 * 1024;
+    faces.statistics.coldBudget = 8 * 1024;
+    faces.priority = 10;
+    // enough for one 4K background, compressing that on eviction would stall the GUI thread
+    KMahjonggCachePartition &backgrounds = partitions[KMahjonggCache::Backgrounds];
+    backgrounds.statistics.budget = 64 * 1024;
+    backgrounds.statistics.coldBudget = 0;
+    backgrounds.priority = 0;
+
+    // destroying pixmaps without the QGuiApplication is undefined, so do not wait for the static destruction
+    if (QCoreApplication *app = QCoreApplication::instance()) {
+        QObject::connect(app, &QCoreApplication::aboutToQuit, app, [this]() {
+            for (KMahjonggCachePartition &partition : partitions) {
+                partition.clear();
+            }
+        });
+    }
+}
+
+KMahjonggCachePrivate *KMahjonggCachePrivate::instance()
+{
+    return s_cache;
+}
+
+bool KMahjonggCachePrivate::find(KMahjonggCache::Partition partition, const QString &key, QPixmap *pixmap)
+{
+    return partitions[partition].find(key, pixmap);
+}
+
+bool KMahjonggCachePrivate::peek(KMahjonggCache::Partition partition, const QString &key, QPixmap *pixmap) const
+{
+    return partitions[partition].peek(key, pixmap);
+}
+
+void KMahjonggCachePrivate::insert(KMahjonggCache::Partition partition, const QString &key, const QPixmap &pixmap)
+{
+    partitions[partition].insert(key, pixmap);
+}
+
+void KMahjonggCachePrivate::removeContaining(KMahjonggCache::Partition partition, const QString &keyPart)
+{
+    partitions[partition].removeContaining(keyPart);
+}
+
+// ---------------------------------------------------------
+
+void KMahjonggCache::setBudget(Partition partition, int kiloBytes)
+{
+    KMahjonggCachePartition &p = s_cache->partition(partition);
+    p.statistics.budget = std::max(0, kiloBytes);
+    p.trim(p.statistics.budget);
+}
+
+int KMahjonggCache::budget(Partition partition)
+{
+    return s_cache->partition(partition).statistics.budget;
+}
+
+void KMahjonggCache::setColdBudget(Partition partition, int kiloBytes)
+{
+    KMahjonggCachePartition &p = s_cache->partition(partition);
+    p.statistics.coldBudget = std::max(0, kiloBytes);
+    p.trimCold(p.statistics.coldBudget);
+}
+
+int KMahjonggCache::coldBudget(Partition partition)
+{
+    return s_cache->partition(partition).statistics.coldBudget;
+}
+
+void KMahjonggCache::setPriority(Partition partition, int priority)
+{
+    s_cache->partition(partition).priority = priority;
+}
+
+int KMahjonggCache::priority(Partition partition)
+{
+    return s_cache->partition(partition).priority;
+}
+
+KMahjonggCache::Statistics KMahjonggCache::statistics(Partition partition)
+{
+    return s_cache->partition(partition).statistics;
+}
+
+void KMahjonggCache::resetStatistics()
+{
+    for (KMahjonggCachePartition &partition : s_cache->partitions) {
+        partition.statistics.hits = 0;
+        partition.statistics.coldHits = 0;
+        partition.statistics.misses = 0;
+        partition.statistics.insertions = 0;
+        partition.statistics.evictions = 0;
+    }
+}
+
+void KMahjonggCache::releaseMemory(MemoryPressure pressure)
+{
+    auto &partitions = s_cache->partitions;
+
+    if (pressure == CriticalPressure) {
+        for (KMahjonggCachePartition &partition : partitions) {
+            partition.statistics.evictions += partition.statistics.entryCount;
+            partition.clear();
+        }
+        return;
+    }
+
+    std::array<KMahjonggCachePartition *, 3> byPriority;
+    std::transform(partitions.begin(), partitions.end(), byPriority.begin(), [](KMahjonggCachePartition &partition) {
+        return &partition;
+    });
+    std::stable_sort(byPriority.begin(), byPriority.end(), [](const KMahjonggCachePartition *a, const KMahjonggCachePartition *b) {
+        return a->priority < b->priority;
+    });
+
+    const int targetCost = totalCost(partitions) / 2;
+    for (KMahjonggCachePartition *partition : byPriority) {
+        const int excess = totalCost(partitions) - targetCost;
+        if (excess <= 0) {
+            break;
+        }
+        partition->trim(std::max(0, partition->statistics.cost - excess));
+    }
+    // including what was just demoted to them
+    for (KMahjonggCachePartition &partition : partitions) {
+        partition.trimCold(partition.statistics.coldCost / 2);
+    }
+}
+
+void KMahjonggCache::clear(Partition partition)
+{
+    s_cache->partition(partition).clear();
+}
+
+void KMahjonggCache::clear()
+{
+    for (KMahjonggCachePartition &partition : s_cache->partitions) {
+        partition.clear();
+    }
+}
@@ -0,0 +1,95 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef KMAHJONGGCACHE_H
+#define KMAHJONGGCACHE_H
+
+// Qt
+#include <QtGlobal>
+
+// LibKMahjongg
+#include <libkmahjongg_export.h>
+
+/**
+ * @class KMahjonggCache kmahjonggcache.h <KMahjonggCache>
+ *
+ * Memory budget of the pixmaps rendered by KMahjonggTileset and KMahjonggBackground.
+ *
+ * Rendered pixmaps are kept in separate partitions, each with its own budget,
+ * so that e.g. a large background pixmap never evicts the tiles currently in use.
+ *
+ * Each partition has two tiers. Pixmaps evicted from the ready to draw hot tier
+ * are kept losslessly compressed in a cold tier, up to its own budget,
+ * and restored from there when needed again, which is much cheaper than rendering them.
+ * All methods are to be called from the GUI thread only.
+ */
+class LIBKMAHJONGG_EXPORT KMahjonggCache
+{
+public:
+    enum Partition {
+        TileBodies,
+        TileFaces,
+        Backgrounds,
+    };
+
+    enum MemoryPressure {
+        /// Evict from the lowest priority partitions until the total cost is halved, and halve the cold tiers
+        ModeratePressure,
+        /// Empty all partitions
+        CriticalPressure,
+    };
+
+    struct Statistics {
+        qint64 hits = 0; ///< found in the hot tier
+        qint64 coldHits = 0; ///< restored from the cold tier
+        qint64 misses = 0;
+        qint64 insertions = 0;
+        qint64 evictions = 0; ///< from the hot tier
+        int entryCount = 0;
+        int cost = 0; ///< in KiB
+        int budget = 0; ///< in KiB
+        int coldEntryCount = 0;
+        int coldCost = 0; ///< in KiB, compressed
+        int coldBudget = 0; ///< in KiB
+    };
+
+    /**
+     * Sets the maximum memory in KiB the pixmaps of @p partition may use.
+     * Least recently used pixmaps are evicted if the new budget is exceeded.
+     */
+    static void setBudget(Partition partition, int kiloBytes);
+    static int budget(Partition partition);
+
+    /**
+     * Sets the maximum memory in KiB the compressed pixmaps of @p partition may use.
+     * 0 disables the cold tier of @p partition.
+     */
+    static void setColdBudget(Partition partition, int kiloBytes);
+    static int coldBudget(Partition partition);
+
+    /**
+     * Sets the priority of @p partition. Partitions with lower priority are
+     * shrunk first when releaseMemory() is called.
+     */
+    static void setPriority(Partition partition, int priority);
+    static int priority(Partition partition);
+
+    static Statistics statistics(Partition partition);
+    static void resetStatistics();
+
+    /**
+     * Hook to be called by the application when the system reports memory pressure.
+     */
+    static void releaseMemory(MemoryPressure pressure);
+
+    static void clear(Partition partition);
+    static void clear();
+
+private:
+    KMahjonggCache() = delete;
+};
+
+#endif // KMAHJONGGCACHE_H
@@ -0,0 +1,107 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef KMAHJONGGCACHE_P_H
+#define KMAHJONGGCACHE_P_H
+
+// own
+#include "kmahjonggcache.h"
+
+// Qt
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QImage>
+#include <QPixmap>
+#include <QString>
+// Std
+#include <array>
+#include <atomic>
+#include <limits>
+#include <list>
+
+class KMahjonggCachePartition
+{
+public:
+    bool find(const QString &key, QPixmap *pixmap);
+    /// like find(), but only in the hot tier and without touching the order or the statistics
+    bool peek(const QString &key, QPixmap *pixmap) const;
+    bool insert(const QString &key, const QPixmap &pixmap);
+    void trim(int maxCost);
+    void trimCold(int maxCost);
+    void clear();
+    /// removes all entries whose key contains @p keyPart
+    void removeContaining(const QString &keyPart);
+
+public:
+    struct Entry {
+        QString key;
+        QPixmap pixmap;
+        int cost;
+    };
+
+    struct ColdEntry {
+        QString key;
+        QByteArray data; // qCompress()ed pixels
+        QSize size;
+        QImage::Format format;
+        qreal dpr;
+        int cost;
+    };
+
+    // most recently used entries at the front
+    std::list<Entry> entries;
+    QHash<QString, std::list<Entry>::iterator> index;
+    std::list<ColdEntry> coldEntries;
+    QHash<QString, std::list<ColdEntry>::iterator> coldIndex;
+
+    KMahjonggCache::Statistics statistics;
+    int priority = 0;
+
+private:
+    void add(const QString &key, const QPixmap &pixmap, int cost);
+    void demote(const Entry &entry);
+    bool restore(const QString &key, QPixmap *pixmap);
+    void removeCold(const QString &key);
+};
+
+class KMahjonggCachePrivate
+{
+public:
+    KMahjonggCachePrivate();
+
+    static KMahjonggCachePrivate *instance();
+
+    bool find(KMahjonggCache::Partition partition, const QString &key, QPixmap *pixmap);
+    bool peek(KMahjonggCache::Partition partition, const QString &key, QPixmap *pixmap) const;
+    void insert(KMahjonggCache::Partition partition, const QString &key, const QPixmap &pixmap);
+    void removeContaining(KMahjonggCache::Partition partition, const QString &keyPart);
+
+    /// to be called when rendering for an actual paint request, from any thread, lets background work yield
+    void noteDemandRender()
+    {
+        lastDemandRender.store(clock.elapsed(), std::memory_order_relaxed);
+    }
+    qint64 msecsSinceDemandRender() const
+    {
+        const qint64 last = lastDemandRender.load(std::memory_order_relaxed);
+        return (last < 0) ? std::numeric_limits<qint64>::max() : clock.elapsed() - last;
+    }
+
+    KMahjonggCachePartition &partition(KMahjonggCache::Partition partition)
+    {
+        return partitions[partition];
+    }
+
+public:
+    std::array<KMahjonggCachePartition, 3> partitions;
+    // started on construction, only read afterwards
+    QElapsedTimer clock;
+    // msecs on the clock, -1 if there was none yet
+    std::atomic<qint64> lastDemandRender{-1};
+};
+
+#endif // KMAHJONGGCACHE_P_H
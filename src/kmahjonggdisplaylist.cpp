@@ -0,0 +1,103 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+// own
+#include "kmahjonggdisplaylist_p.h"
+
+// Qt
+#include <QByteArray>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPainter>
+#include <QPicture>
+// Std
+#include <vector>
+
+class KMahjonggDisplayList::Recording
+{
+public:
+    std::unique_ptr<QPicture> acquire();
+    void release(std::unique_ptr<QPicture> picture);
+
+public:
+    QSizeF size;
+    QByteArray data;
+
+private:
+    QMutex mutex;
+    // parsed pictures not in use by any replay
+    std::vector<std::unique_ptr<QPicture>> idlePictures;
+};
+
+std::unique_ptr<QPicture> KMahjonggDisplayList::Recording::acquire()
+{
+    {
+        const QMutexLocker locker(&mutex);
+
+        if (!idlePictures.empty()) {
+            std::unique_ptr<QPicture> picture = std::move(idlePictures.back());
+            idlePictures.pop_back();
+            return picture;
+        }
+    }
+
+    // all in use by other threads, so parse another one
+    auto picture = std::make_unique<QPicture>();
+    picture->setData(data.constData(), data.size());
+    return picture;
+}
+
+void KMahjonggDisplayList::Recording::release(std::unique_ptr<QPicture> picture)
+{
+    const QMutexLocker locker(&mutex);
+
+    idlePictures.push_back(std::move(picture));
+}
+
+KMahjonggDisplayList KMahjonggDisplayList::record(QSizeF size, const std::function<void(QPainter *)> &paint)
+{
+    KMahjonggDisplayList list;
+    if (size.isEmpty()) {
+        return list;
+    }
+
+    auto picture = std::make_unique<QPicture>();
+    QPainter painter(picture.get());
+    paint(&painter);
+    if (!painter.end()) {
+        return list;
+    }
+
+    auto recording = std::make_shared<Recording>();
+    recording->size = size;
+    recording->data = QByteArray(picture->data(), picture->size());
+    // the recorded picture is the first one to replay
+    recording->release(std::move(picture));
+    list.m_recording = std::move(recording);
+    return list;
+}
+
+bool KMahjonggDisplayList::covers(QSizeF size) const
+{
+    return m_recording && size.width() <= m_recording->size.width() && size.height() <= m_recording->size.height();
+}
+
+void KMahjonggDisplayList::replay(QPainter *painter, const QRectF &bounds) const
+{
+    if (isNull() || bounds.isEmpty()) {
+        return;
+    }
+
+    std::unique_ptr<QPicture> picture = m_recording->acquire();
+
+    painter->save();
+    painter->translate(bounds.topLeft());
+    painter->scale(bounds.width() / m_recording->size.width(), bounds.height() / m_recording->size.height());
+    picture->play(painter);
+    painter->restore();
+
+    m_recording->release(std::move(picture));
+}
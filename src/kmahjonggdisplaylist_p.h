@@ -0,0 +1,55 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef KMAHJONGGDISPLAYLIST_P_H
+#define KMAHJONGGDISPLAYLIST_P_H
+
+// Qt
+#include <QRectF>
+#include <QSizeF>
+// Std
+#include <functional>
+#include <memory>
+
+class QPainter;
+
+/**
+ * Painter commands recorded once, e.g. of an SVG element, to be replayed at smaller sizes.
+ *
+ * Recording flattens the document into paths, brushes and transforms,
+ * so replaying skips the element lookup and style resolution of QSvgRenderer.
+ * Some content, like filter effects, is only kept at the resolution recorded,
+ * so larger sizes should be rendered from the SVG instead, see covers().
+ *
+ * The recorded QPicture is kept parsed. As QPicture::play() is not reentrant,
+ * concurrent replays each lease a picture of their own, parsed once on demand.
+ * Copies share the recording.
+ */
+class KMahjonggDisplayList
+{
+public:
+    KMahjonggDisplayList() = default;
+
+    /// records what @p paint draws into the rectangle of @p size at the origin
+    static KMahjonggDisplayList record(QSizeF size, const std::function<void(QPainter *)> &paint);
+
+    bool isNull() const
+    {
+        return !m_recording;
+    }
+
+    /// whether replaying at @p size keeps all detail, so @p size is not larger than the one recorded
+    bool covers(QSizeF size) const;
+
+    /// replays the commands scaled to fill @p bounds
+    void replay(QPainter *painter, const QRectF &bounds) const;
+
+private:
+    class Recording;
+    std::shared_ptr<Recording> m_recording;
+};
+
+#endif // KMAHJONGGDISPLAYLIST_P_H
@@ -0,0 +1,93 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+// own
+#include "kmahjonggelementhash_p.h"
+
+// Qt
+#include <QCryptographicHash>
+#include <QSet>
+#include <QXmlStreamReader>
+// Std
+#include <memory>
+#include <vector>
+
+namespace
+{
+struct OpenElement {
+    QString id;
+    int depth;
+    std::unique_ptr<QCryptographicHash> hash;
+};
+
+void addToken(QCryptographicHash &hash, const QXmlStreamReader &reader)
+{
+    // separators keep different token sequences from resulting in the same bytes
+    switch (reader.tokenType()) {
+    case QXmlStreamReader::StartElement:
+        hash.addData("<");
+        hash.addData(reader.qualifiedName().toUtf8());
+        for (const QXmlStreamAttribute &attribute : reader.attributes()) {
+            hash.addData(" ");
+            hash.addData(attribute.qualifiedName().toUtf8());
+            hash.addData("=");
+            hash.addData(attribute.value().toUtf8());
+        }
+        hash.addData(">");
+        break;
+    case QXmlStreamReader::EndElement:
+        hash.addData("</>");
+        break;
+    case QXmlStreamReader::Characters:
+        if (!reader.isWhitespace()) {
+            hash.addData(reader.text().toUtf8());
+        }
+        break;
+    default:
+        break;
+    }
+}
+}
+
+QHash<QString, QByteArray> KMahjonggElementHash::subtreeHashes(QIODevice *device, const QStringList &elementIds, QByteArray *sharedHash)
+{
+    QHash<QString, QByteArray> result;
+    const QSet<QString> wantedIds(elementIds.cbegin(), elementIds.cend());
+
+    // elements can be nested, so all open ones get the tokens
+    std::vector<OpenElement> openElements;
+    int depth = 0;
+    QCryptographicHash outsideHash(QCryptographicHash::Sha1);
+
+    QXmlStreamReader reader(device);
+    while (!reader.atEnd()) {
+        reader.readNext();
+        if (reader.isStartElement()) {
+            ++depth;
+            const QString id = reader.attributes().value(QLatin1String("id")).toString();
+            if (!id.isEmpty() && wantedIds.contains(id)) {
+                openElements.push_back({id, depth, std::make_unique<QCryptographicHash>(QCryptographicHash::Sha1)});
+            }
+        }
+        for (const OpenElement &element : openElements) {
+            addToken(*element.hash, reader);
+        }
+        if (openElements.empty() && sharedHash) {
+            addToken(outsideHash, reader);
+        }
+        if (reader.isEndElement()) {
+            if (!openElements.empty() && openElements.back().depth == depth) {
+                result.insert(openElements.back().id, openElements.back().hash->result().toHex());
+                openElements.pop_back();
+            }
+            --depth;
+        }
+    }
+    if (sharedHash) {
+        *sharedHash = outsideHash.result().toHex();
+    }
+    return result;
+}
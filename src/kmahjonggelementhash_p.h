@@ -0,0 +1,34 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef KMAHJONGGELEMENTHASH_P_H
+#define KMAHJONGGELEMENTHASH_P_H
+
+// Qt
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+class QIODevice;
+
+namespace KMahjonggElementHash
+{
+
+/**
+ * Hashes the XML subtrees of the elements with the ids @p elementIds
+ * in the uncompressed SVG document read from @p device.
+ *
+ * Content referenced from outside the subtree, like gradients in the defs, is not covered,
+ * for that @p sharedHash is set to the hash of everything outside the subtrees, if passed.
+ * Also used by the build tool generating the element index, so both agree on the values.
+ * @return hex encoded hashes by element id, without the ids which were not found
+ */
+QHash<QString, QByteArray> subtreeHashes(QIODevice *device, const QStringList &elementIds, QByteArray *sharedHash = nullptr);
+
+}
+
+#endif // KMAHJONGGELEMENTHASH_P_H
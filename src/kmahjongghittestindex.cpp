@@ -0,0 +1,188 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+// own
+#include "kmahjongghittestindex.h"
+
+// Std
+#include <algorithm>
+#include <vector>
+
+// LibKMahjongg
+#include "kmahjonggboardgeometry_p.h"
+
+class KMahjonggHitTestIndexPrivate
+{
+public:
+    explicit KMahjonggHitTestIndexPrivate(const KMahjonggTileset *tileset)
+        : tileset(tileset)
+    {
+    }
+
+    int cellIndex(int x, int y, int level) const
+    {
+        return (level * geometry.rows + y) * geometry.columns + x;
+    }
+    bool isInside(int x, int y, int level) const
+    {
+        return x >= 0 && x < geometry.columns && y >= 0 && y < geometry.rows && level >= 0 && level < geometry.levels;
+    }
+    void insertIntoGrid(int id);
+    void removeFromGrid(int id);
+    void rebuild();
+
+public:
+    const KMahjonggTileset *tileset;
+    KMahjonggBoardGeometry geometry;
+
+    std::vector<KMahjonggTilePlacement> tiles;
+    std::vector<bool> present;
+    // id of the tile covering a quarter cell, per level, -1 for none
+    std::vector<int> grid;
+};
+
+void KMahjonggHitTestIndexPrivate::insertIntoGrid(int id)
+{
+    const KMahjonggTilePlacement &tile = tiles[id];
+    // a tile covers 2x2 quarter cells
+    for (int y = tile.y; y < tile.y + 2; ++y) {
+        for (int x = tile.x; x < tile.x + 2; ++x) {
+            if (isInside(x, y, tile.level)) {
+                grid[cellIndex(x, y, tile.level)] = id;
+            }
+        }
+    }
+}
+
+void KMahjonggHitTestIndexPrivate::removeFromGrid(int id)
+{
+    const KMahjonggTilePlacement &tile = tiles[id];
+    for (int y = tile.y; y < tile.y + 2; ++y) {
+        for (int x = tile.x; x < tile.x + 2; ++x) {
+            if (isInside(x, y, tile.level) && grid[cellIndex(x, y, tile.level)] == id) {
+                grid[cellIndex(x, y, tile.level)] = -1;
+            }
+        }
+    }
+}
+
+void KMahjonggHitTestIndexPrivate::rebuild()
+{
+    grid.assign(static_cast<size_t>(std::max(0, geometry.columns)) * std::max(0, geometry.rows) * geometry.levels, -1);
+    for (int id = 0; id < static_cast<int>(tiles.size()); ++id) {
+        if (present[id]) {
+            insertIntoGrid(id);
+        }
+    }
+}
+
+// ---------------------------------------------------------
+
+KMahjonggHitTestIndex::KMahjonggHitTestIndex(const KMahjonggTileset *tileset)
+    : d_ptr(new KMahjonggHitTestIndexPrivate(tileset))
+{
+}
+
+KMahjonggHitTestIndex::~KMahjonggHitTestIndex() = default;
+
+void KMahjonggHitTestIndex::setTileVariant(int variant)
+{
+    Q_D(KMahjonggHitTestIndex);
+
+    if (variant < 0 || variant > 3) {
+        return;
+    }
+    // only affects the mapping of points to cells
+    d->geometry.variant = variant;
+}
+
+void KMahjonggHitTestIndex::setBoardSize(int columns, int rows, int levels)
+{
+    Q_D(KMahjonggHitTestIndex);
+
+    d->geometry.columns = columns;
+    d->geometry.rows = rows;
+    d->geometry.levels = std::max(1, levels);
+    d->rebuild();
+}
+
+void KMahjonggHitTestIndex::setTiles(const QList<KMahjonggTilePlacement> &tiles)
+{
+    Q_D(KMahjonggHitTestIndex);
+
+    d->tiles.assign(tiles.cbegin(), tiles.cend());
+    d->present.assign(tiles.size(), true);
+    d->rebuild();
+}
+
+int KMahjonggHitTestIndex::addTile(const KMahjonggTilePlacement &tile)
+{
+    Q_D(KMahjonggHitTestIndex);
+
+    const int id = static_cast<int>(d->tiles.size());
+    d->tiles.push_back(tile);
+    d->present.push_back(true);
+    d->insertIntoGrid(id);
+    return id;
+}
+
+void KMahjonggHitTestIndex::removeTile(int id)
+{
+    Q_D(KMahjonggHitTestIndex);
+
+    if (id < 0 || id >= static_cast<int>(d->tiles.size()) || !d->present[id]) {
+        return;
+    }
+    d->present[id] = false;
+    d->removeFromGrid(id);
+}
+
+int KMahjonggHitTestIndex::tileAt(QPoint pos) const
+{
+    Q_D(const KMahjonggHitTestIndex);
+
+    // cells are mapped with the current tile size, so no update is needed on resize
+    KMahjonggBoardGeometry geometry = d->geometry;
+    geometry.metrics = KMahjonggBoardMetrics::fromTileset(d->tileset);
+    const KMahjonggBoardMetrics &metrics = geometry.metrics;
+    if (metrics.qw <= 0 || metrics.qh <= 0) {
+        return -1;
+    }
+
+    // the cells are where the faces are, the bodies reach beyond them with their 3D sides
+    const QPoint faceOffset = geometry.faceOffset(QSize(metrics.fw, metrics.fh));
+    const int reachX = 2 + (metrics.w - metrics.fw + metrics.qw - 1) / metrics.qw;
+    const int reachY = 2 + (metrics.h - metrics.fh + metrics.qh - 1) / metrics.qh;
+    const auto floorDiv = [](int value, int divisor) {
+        return (value >= 0) ? (value / divisor) : -((divisor - 1 - value) / divisor);
+    };
+
+    for (int level = geometry.levels - 1; level >= 0; --level) {
+        const QPoint relativePos = pos - geometry.levelShift(level) - faceOffset;
+        const int cellX = floorDiv(relativePos.x(), metrics.qw);
+        const int cellY = floorDiv(relativePos.y(), metrics.qh);
+        // of the tiles with a body at pos, the one painted last
+        int hit = -1;
+        for (int y = cellY - reachY; y <= cellY + reachY; ++y) {
+            for (int x = cellX - reachX; x <= cellX + reachX; ++x) {
+                if (!d->isInside(x, y, level)) {
+                    continue;
+                }
+                const int id = d->grid[d->cellIndex(x, y, level)];
+                if (id < 0 || id == hit || !geometry.opaqueRect(d->tiles[id]).contains(pos)) {
+                    continue;
+                }
+                if (hit < 0 || geometry.drawsBefore(d->tiles[hit], d->tiles[id])) {
+                    hit = id;
+                }
+            }
+        }
+        if (hit >= 0) {
+            return hit;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,62 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef KMAHJONGGHITTESTINDEX_H
+#define KMAHJONGGHITTESTINDEX_H
+
+// Qt
+#include <QtClassHelperMacros> // Q_DECLARE_PRIVATE
+#include <QList>
+#include <QPoint>
+// Std
+#include <memory>
+
+// LibKMahjongg
+#include "kmahjonggboardcompositor.h"
+#include <libkmahjongg_export.h>
+
+class KMahjonggTileset;
+class KMahjonggHitTestIndexPrivate;
+
+/**
+ * @class KMahjonggHitTestIndex kmahjongghittestindex.h <KMahjonggHitTestIndex>
+ *
+ * Finds the topmost tile at a point of a board of stacked tiles.
+ *
+ * The tiles are kept in a grid of quarter cells per level, so a lookup
+ * only checks one cell per level, independent of the number of tiles.
+ * Tiles are identified by ids, given in the order of setTiles() and addTile(),
+ * like with KMahjonggBoardCompositor.
+ */
+class LIBKMAHJONGG_EXPORT KMahjonggHitTestIndex
+{
+public:
+    explicit KMahjonggHitTestIndex(const KMahjonggTileset *tileset);
+    ~KMahjonggHitTestIndex();
+
+    /// as KMahjonggBoardCompositor::setTileVariant()
+    void setTileVariant(int variant);
+    /// as KMahjonggBoardCompositor::setBoardSize()
+    void setBoardSize(int columns, int rows, int levels);
+
+    void setTiles(const QList<KMahjonggTilePlacement> &tiles);
+    /// @return the id of the added tile
+    int addTile(const KMahjonggTilePlacement &tile);
+    void removeTile(int id);
+
+    /**
+     * @param pos in logical pixels, relative to the board origin
+     * @return the id of the topmost tile whose body, face or 3D sides, is at @p pos, or -1 if there is none
+     */
+    int tileAt(QPoint pos) const;
+
+private:
+    std::unique_ptr<KMahjonggHitTestIndexPrivate> const d_ptr;
+    Q_DECLARE_PRIVATE(KMahjonggHitTestIndex)
+    Q_DISABLE_COPY(KMahjonggHitTestIndex)
+};
+
+#endif // KMAHJONGGHITTESTINDEX_H
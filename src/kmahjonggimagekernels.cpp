@@ -0,0 +1,191 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+// own
+#include "kmahjonggimagekernels_p.h"
+
+// Std
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+
+// exact x / 255 with rounding, for x <= 255 * 255
+inline quint32 div255(quint32 x)
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+// The weight is scaled to 0..128, so the blend fits in 16 bit lanes.
+// The tint is premultiplied with the alpha of each pixel, so the alpha itself is kept
+// and the colour channels never exceed it.
+inline quint32 tintPixel(quint32 pixel, const quint32 tint[4], quint32 weight)
+{
+    const quint32 alpha = pixel >> 24;
+    quint32 result = 0;
+    for (int shift = 0, channel = 0; shift < 32; shift += 8, ++channel) {
+        const quint32 value = (pixel >> shift) & 0xff;
+        const quint32 tinted = div255(tint[channel] * alpha);
+        result |= ((value * (128 - weight) + tinted * weight) >> 7) << shift;
+    }
+    return result;
+}
+
+#if defined(__SSE2__)
+// same as tintPixel(), for two pixels unpacked to 16 bit lanes
+inline __m128i tintPixels(__m128i pixels, __m128i tint, __m128i weight, __m128i inverseWeight)
+{
+    __m128i alpha = _mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3));
+    alpha = _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+
+    __m128i tinted = _mm_add_epi16(_mm_mullo_epi16(alpha, tint), _mm_set1_epi16(128));
+    tinted = _mm_srli_epi16(_mm_add_epi16(tinted, _mm_srli_epi16(tinted, 8)), 8);
+
+    const __m128i blended = _mm_add_epi16(_mm_mullo_epi16(pixels, inverseWeight), _mm_mullo_epi16(tinted, weight));
+    return _mm_srli_epi16(blended, 7);
+}
+
+// averages the two pixel pairs of one row pair, @p top and @p bottom holding 4 pixels each,
+// into two pixels in the low half of the result
+inline __m128i boxPixels(__m128i top, __m128i bottom)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i left = _mm_add_epi16(_mm_unpacklo_epi8(top, zero), _mm_unpacklo_epi8(bottom, zero));
+    const __m128i right = _mm_add_epi16(_mm_unpackhi_epi8(top, zero), _mm_unpackhi_epi8(bottom, zero));
+    const __m128i leftSum = _mm_add_epi16(left, _mm_srli_si128(left, 8));
+    const __m128i rightSum = _mm_add_epi16(right, _mm_srli_si128(right, 8));
+    __m128i sum = _mm_unpacklo_epi64(leftSum, rightSum);
+    sum = _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(2)), 2);
+    return _mm_packus_epi16(sum, zero);
+}
+#endif
+
+// rounded average of four pixels, per channel
+inline quint32 boxPixel(quint32 a, quint32 b, quint32 c, quint32 d)
+{
+    quint32 result = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        const quint32 sum = ((a >> shift) & 0xff) + ((b >> shift) & 0xff) + ((c >> shift) & 0xff) + ((d >> shift) & 0xff);
+        result |= ((sum + 2) >> 2) << shift;
+    }
+    return result;
+}
+
+void tintImage(QImage &image, const QColor &color, qreal strength, [[maybe_unused]] bool useSimd)
+{
+    if (image.isNull() || !color.isValid() || strength <= 0.0) {
+        return;
+    }
+    if (image.format() != QImage::Format_ARGB32_Premultiplied) {
+        image.convertTo(QImage::Format_ARGB32_Premultiplied);
+    }
+
+    const quint32 weight = static_cast<quint32>(std::lround(std::min(strength, 1.0) * 128));
+    // in the channel order of the pixels in memory, the alpha blends to itself
+    const quint32 tint[4] = {static_cast<quint32>(color.blue()), static_cast<quint32>(color.green()), static_cast<quint32>(color.red()), 255};
+
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i tintLanes = _mm_set_epi16(255, tint[2], tint[1], tint[0], 255, tint[2], tint[1], tint[0]);
+    const __m128i weightLanes = _mm_set1_epi16(static_cast<short>(weight));
+    const __m128i inverseWeightLanes = _mm_set1_epi16(static_cast<short>(128 - weight));
+#endif
+
+    const int width = image.width();
+    for (int y = 0; y < image.height(); ++y) {
+        auto *line = reinterpret_cast<quint32 *>(image.scanLine(y));
+        int x = 0;
+#if defined(__SSE2__)
+        for (; useSimd && x + 4 <= width; x += 4) {
+            const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(line + x));
+            const __m128i low = tintPixels(_mm_unpacklo_epi8(pixels, zero), tintLanes, weightLanes, inverseWeightLanes);
+            const __m128i high = tintPixels(_mm_unpackhi_epi8(pixels, zero), tintLanes, weightLanes, inverseWeightLanes);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(line + x), _mm_packus_epi16(low, high));
+        }
+#endif
+        for (; x < width; ++x) {
+            line[x] = tintPixel(line[x], tint, weight);
+        }
+    }
+}
+
+QImage halvedImage(const QImage &image, [[maybe_unused]] bool useSimd)
+{
+    if (image.isNull()) {
+        return image;
+    }
+    const QImage source = (image.format() == QImage::Format_ARGB32_Premultiplied) ? image : image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+    const int sourceWidth = source.width();
+    const int sourceHeight = source.height();
+    QImage result((sourceWidth + 1) / 2, (sourceHeight + 1) / 2, QImage::Format_ARGB32_Premultiplied);
+    result.setDevicePixelRatio(source.devicePixelRatio());
+
+    // the pixel pairs complete in the source, the odd last one is done by the scalar loop
+    const int pairedWidth = sourceWidth / 2;
+    for (int y = 0; y < result.height(); ++y) {
+        const auto *top = reinterpret_cast<const quint32 *>(source.constScanLine(2 * y));
+        const auto *bottom = reinterpret_cast<const quint32 *>(source.constScanLine(std::min(2 * y + 1, sourceHeight - 1)));
+        auto *line = reinterpret_cast<quint32 *>(result.scanLine(y));
+        int x = 0;
+#if defined(__SSE2__)
+        for (; useSimd && x + 2 <= pairedWidth; x += 2) {
+            const __m128i topPixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(top + 2 * x));
+            const __m128i bottomPixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bottom + 2 * x));
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(line + x), boxPixels(topPixels, bottomPixels));
+        }
+#endif
+        for (; x < result.width(); ++x) {
+            const int right = std::min(2 * x + 1, sourceWidth - 1);
+            line[x] = boxPixel(top[2 * x], top[right], bottom[2 * x], bottom[right]);
+        }
+    }
+    return result;
+}
+
+}
+
+void KMahjonggImageKernels::tint(QImage &image, const QColor &color, qreal strength)
+{
+    tintImage(image, color, strength, true);
+}
+
+void KMahjonggImageKernels::tintReference(QImage &image, const QColor &color, qreal strength)
+{
+    tintImage(image, color, strength, false);
+}
+
+QImage KMahjonggImageKernels::halved(const QImage &image)
+{
+    return halvedImage(image, true);
+}
+
+QImage KMahjonggImageKernels::halvedReference(const QImage &image)
+{
+    return halvedImage(image, false);
+}
+
+QImage KMahjonggImageKernels::downsampled(const QImage &image, QSize size)
+{
+    if (image.isNull() || size.isEmpty() || image.size() == size) {
+        return image;
+    }
+
+    QImage result = image;
+    while (result.width() >= 2 * size.width() && result.height() >= 2 * size.height()) {
+        result = halved(result);
+    }
+    if (result.size() != size) {
+        result = result.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+    return result;
+}
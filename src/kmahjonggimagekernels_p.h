@@ -0,0 +1,49 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef KMAHJONGGIMAGEKERNELS_P_H
+#define KMAHJONGGIMAGEKERNELS_P_H
+
+// Qt
+#include <QColor>
+#include <QImage>
+
+namespace KMahjonggImageKernels
+{
+
+/**
+ * Blends the colour of all pixels of @p image towards @p color, keeping their alpha.
+ *
+ * Works in place on premultiplied ARGB32, other formats are converted first.
+ * @param strength from 0.0 (unchanged) to 1.0 (plain @p color)
+ */
+void tint(QImage &image, const QColor &color, qreal strength);
+
+/**
+ * Halves @p image in both directions with a 2x2 box filter.
+ *
+ * Works on premultiplied ARGB32, other formats are converted first.
+ * Odd sizes are rounded up, repeating the last column or row.
+ */
+QImage halved(const QImage &image);
+
+/**
+ * Scales @p image down to @p size, by halving it with halved() as long as
+ * that stays at least @p size, then smoothly scaling the rest of the way.
+ * Larger sizes are scaled up smoothly.
+ */
+QImage downsampled(const QImage &image, QSize size);
+
+/**
+ * tint() and halved() without any SIMD code path, which have to give the same results.
+ * For checking them, see the kmahjonggkernelcheck tool.
+ */
+void tintReference(QImage &image, const QColor &color, qreal strength);
+QImage halvedReference(const QImage &image);
+
+}
+
+#endif // KMAHJONGGIMAGEKERNELS_P_H
@@ -0,0 +1,156 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+// own
+#include "kmahjonggimageprovider.h"
+
+// Qt
+#include <QPainter>
+
+// LibKMahjongg
+#include "kmahjonggbackground.h"
+#include "kmahjonggtileset.h"
+
+namespace
+{
+constexpr int atlasColumnCount = 8;
+
+QSize parseSize(QStringView text)
+{
+    const int separator = text.indexOf(QLatin1Char('x'));
+    if (separator < 0) {
+        return QSize();
+    }
+    return QSize(text.left(separator).toInt(), text.mid(separator + 1).toInt());
+}
+}
+
+class KMahjonggImageProviderPrivate
+{
+public:
+    KMahjonggImageProviderPrivate(const KMahjonggTileset *tileset, const KMahjonggBackground *background)
+        : tileset(tileset)
+        , background(background)
+    {
+    }
+
+    qreal tileScale(QSize tileSize) const;
+
+public:
+    const KMahjonggTileset *const tileset;
+    const KMahjonggBackground *const background;
+};
+
+namespace
+{
+// the image getters render at the current tile size, times the device pixel ratio
+qreal tileScale(const KMahjonggTileset &tileset, QSize tileSize)
+{
+    if (tileset.width() <= 0 || tileSize.isEmpty()) {
+        return 0;
+    }
+    return static_cast<qreal>(tileSize.width()) / tileset.width();
+}
+}
+
+qreal KMahjonggImageProviderPrivate::tileScale(QSize tileSize) const
+{
+    return tileset ? ::tileScale(*tileset, tileSize) : 0;
+}
+
+QImage KMahjonggImageProvider::atlas(const KMahjonggTileset &tileset, QSize tileSize, QSize *faceSize)
+{
+    const qreal scale = ::tileScale(tileset, tileSize);
+    if (scale <= 0) {
+        return QImage();
+    }
+
+    QList<QImage> elements;
+    elements.reserve(2 * KMahjonggTileset::BodyCount + KMahjonggTileset::FaceCount);
+    for (int num = 0; num < KMahjonggTileset::BodyCount; ++num) {
+        elements.append(tileset.unselectedTileImage(num, scale));
+    }
+    for (int num = 0; num < KMahjonggTileset::BodyCount; ++num) {
+        elements.append(tileset.selectedTileImage(num, scale));
+    }
+    for (int num = 0; num < KMahjonggTileset::FaceCount; ++num) {
+        elements.append(tileset.tilefaceImage(num, scale));
+    }
+
+    const QSize cellSize = elements.first().size();
+    if (faceSize) {
+        *faceSize = elements.last().size();
+    }
+    const int rowCount = (elements.size() + atlasColumnCount - 1) / atlasColumnCount;
+    QImage atlas(cellSize.width() * atlasColumnCount, cellSize.height() * rowCount, QImage::Format_ARGB32_Premultiplied);
+    atlas.fill(Qt::transparent);
+    QPainter painter(&atlas);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    for (int element = 0; element < elements.size(); ++element) {
+        QImage image = elements.at(element);
+        // placed in device pixels
+        image.setDevicePixelRatio(1.0);
+        painter.drawImage(KMahjonggImageProvider::atlasRect(element, cellSize, image.size()).topLeft(), image);
+    }
+    return atlas;
+}
+
+KMahjonggImageProvider::KMahjonggImageProvider(const KMahjonggTileset *tileset, const KMahjonggBackground *background)
+    // the getters are thread-safe, so never block the GUI thread
+    : QQuickImageProvider(QQuickImageProvider::Image, QQmlImageProviderBase::ForceAsynchronousImageLoading)
+    , d_ptr(new KMahjonggImageProviderPrivate(tileset, background))
+{
+}
+
+KMahjonggImageProvider::~KMahjonggImageProvider() = default;
+
+QImage KMahjonggImageProvider::requestImage(const QString &id, QSize *size, const QSize &requestedSize)
+{
+    Q_D(KMahjonggImageProvider);
+
+    Q_UNUSED(requestedSize);
+
+    const QStringList parts = id.split(QLatin1Char('/'));
+    const QString kind = parts.value(0);
+    const QSize tileSize = parseSize(parts.value(1));
+
+    QImage image;
+    if (kind == QLatin1String("atlas")) {
+        if (d->tileset) {
+            image = atlas(*d->tileset, tileSize);
+        }
+    } else if (kind == QLatin1String("background")) {
+        if (d->background) {
+            image = d->background->backgroundImage(1.0);
+        }
+    } else if (parts.size() == 3) {
+        const qreal scale = d->tileScale(tileSize);
+        bool isNumber = false;
+        const int num = parts.at(2).toInt(&isNumber);
+        if (scale > 0 && isNumber) {
+            if (kind == QLatin1String("tile")) {
+                image = d->tileset->unselectedTileImage(num, scale);
+            } else if (kind == QLatin1String("selected")) {
+                image = d->tileset->selectedTileImage(num, scale);
+            } else if (kind == QLatin1String("face")) {
+                image = d->tileset->tilefaceImage(num, scale);
+            }
+        }
+    }
+
+    // QML works in device pixels here
+    image.setDevicePixelRatio(1.0);
+    if (size) {
+        *size = image.size();
+    }
+    return image;
+}
+
+QRect KMahjonggImageProvider::atlasRect(int element, QSize tileSize, QSize faceSize)
+{
+    const QPoint topLeft((element % atlasColumnCount) * tileSize.width(), (element / atlasColumnCount) * tileSize.height());
+    return QRect(topLeft, (element < 2 * KMahjonggTileset::BodyCount) ? tileSize : faceSize);
+}
@@ -0,0 +1,76 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef KMAHJONGGIMAGEPROVIDER_H
+#define KMAHJONGGIMAGEPROVIDER_H
+
+// Qt
+#include <QQuickImageProvider>
+// Std
+#include <memory>
+
+// LibKMahjongg
+#include <libkmahjonggquick_export.h>
+
+class KMahjonggTileset;
+class KMahjonggBackground;
+class KMahjonggImageProviderPrivate;
+
+/**
+ * @class KMahjonggImageProvider kmahjonggimageprovider.h <KMahjonggImageProvider>
+ *
+ * Serves the images of a tileset and a background to QML.
+ *
+ * Part of the separate KMahjongglib6Quick library target, only available if built with Qt Quick.
+ * The ids, each with the size wanted in device pixels:
+ * - "atlas/WxH": all tile elements for tile size WxH, see atlasRect()
+ * - "tile/WxH/n", "selected/WxH/n": tile body n (0 to 3)
+ * - "face/WxH/n": tile face n, W and H being the size of the whole tile
+ * - "background/WxH": the background, with the size it was last given by
+ *   KMahjonggBackground::sizeChanged(), WxH only serves to make QML reload it
+ *
+ * Qt Quick makes a separate texture for every distinct Image::sourceClipRect,
+ * so cutting tiles out of the atlas that way does not save any draw calls.
+ * To draw a whole board from one texture, use KMahjonggAtlasItem instead.
+ * The images are made on the QML image loading threads, with the thread-safe
+ * QImage getters of KMahjonggTileset and KMahjonggBackground. So the tileset
+ * and background may not be loaded or resized while images are requested.
+ * @code
+ * engine->addImageProvider(QStringLiteral("kmahjongg"), new KMahjonggImageProvider(&tileset, &background));
+ * @endcode
+ */
+class LIBKMAHJONGGQUICK_EXPORT KMahjonggImageProvider : public QQuickImageProvider
+{
+public:
+    /// neither is owned, both may be nullptr
+    KMahjonggImageProvider(const KMahjonggTileset *tileset, const KMahjonggBackground *background);
+    ~KMahjonggImageProvider() override;
+
+    QImage requestImage(const QString &id, QSize *size, const QSize &requestedSize) override;
+
+    /**
+     * Rectangle of element @p element in the atlas for tile size @p tileSize.
+     *
+     * The elements are numbered like in the tileset: 0 to 3 are the tile bodies,
+     * 4 to 7 the selected ones, followed by the faces. They are placed in rows of
+     * 8 cells of tile size, each at the top-left corner of its cell.
+     * @param faceSize the size of the faces, e.g. from the size of "face/WxH/0"
+     */
+    static QRect atlasRect(int element, QSize tileSize, QSize faceSize);
+
+    /**
+     * The image served for "atlas/WxH", for tile size @p tileSize in device pixels.
+     * @param faceSize set to the size of the faces in the atlas, if passed
+     */
+    static QImage atlas(const KMahjonggTileset &tileset, QSize tileSize, QSize *faceSize = nullptr);
+
+private:
+    std::unique_ptr<KMahjonggImageProviderPrivate> const d_ptr;
+    Q_DECLARE_PRIVATE(KMahjonggImageProvider)
+    Q_DISABLE_COPY(KMahjonggImageProvider)
+};
+
+#endif // KMAHJONGGIMAGEPROVIDER_H
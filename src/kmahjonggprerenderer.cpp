@@ -0,0 +1,138 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+// own
+#include "kmahjonggprerenderer.h"
+
+// Qt
+#include <QGuiApplication>
+#include <QList>
+#include <QScreen>
+#include <QTimer>
+
+// LibKMahjongg
+#include "kmahjonggcache_p.h"
+#include "kmahjonggtileset.h"
+#include "kmahjonggutils_p.h"
+
+namespace
+{
+// how long to stay quiet after rendering for painting
+constexpr int idleDelay = 500;
+}
+
+class KMahjonggPrerendererPrivate
+{
+public:
+    explicit KMahjonggPrerendererPrivate(KMahjonggTileset *tileset)
+        : tileset(tileset)
+    {
+    }
+
+public:
+    KMahjonggTileset *tileset;
+    // tile sizes
+    QList<QSize> candidates;
+    int candidateIndex = 0;
+    int elementIndex = 0;
+    QTimer timer;
+};
+
+KMahjonggPrerenderer::KMahjonggPrerenderer(KMahjonggTileset *tileset, QObject *parent)
+    : QObject(parent)
+    , d_ptr(new KMahjonggPrerendererPrivate(tileset))
+{
+    Q_D(KMahjonggPrerenderer);
+
+    d->timer.setSingleShot(true);
+
+    connect(&d->timer, &QTimer::timeout, this, [this]() {
+        Q_D(KMahjonggPrerenderer);
+
+        const qint64 sinceDemandRender = KMahjonggCachePrivate::instance()->msecsSinceDemandRender();
+        if (sinceDemandRender < idleDelay) {
+            d->timer.start(static_cast<int>(idleDelay - sinceDemandRender));
+            return;
+        }
+
+        if (d->elementIndex >= d->tileset->prerenderElementCount()) {
+            d->elementIndex = 0;
+            ++d->candidateIndex;
+        }
+        if (d->candidateIndex >= d->candidates.size()) {
+            Q_EMIT finished();
+            return;
+        }
+
+        // bodies come first in the table, which are needed for every tile
+        // the ratio the pixmap getters use, which might have changed since adding the candidate
+        d->tileset->prerenderElement(d->elementIndex, d->candidates.at(d->candidateIndex), KMahjonggUtils::defaultDevicePixelRatio());
+        ++d->elementIndex;
+        d->timer.start(0);
+    });
+}
+
+KMahjonggPrerenderer::~KMahjonggPrerenderer() = default;
+
+void KMahjonggPrerenderer::addCandidate(QSize tileSize)
+{
+    Q_D(KMahjonggPrerenderer);
+
+    if (tileSize.isEmpty() || d->candidates.contains(tileSize)) {
+        return;
+    }
+    d->candidates.append(tileSize);
+}
+
+void KMahjonggPrerenderer::addBoardCandidate(QSize boardSize, int horizontalCells, int verticalCells)
+{
+    Q_D(KMahjonggPrerenderer);
+
+    addCandidate(d->tileset->preferredTileSize(boardSize, horizontalCells, verticalCells));
+}
+
+void KMahjonggPrerenderer::addScreenCandidates(int horizontalCells, int verticalCells)
+{
+    const QList<QScreen *> screens = QGuiApplication::screens();
+    for (const QScreen *screen : screens) {
+        addBoardCandidate(screen->size(), horizontalCells, verticalCells);
+        addBoardCandidate(screen->availableSize(), horizontalCells, verticalCells);
+    }
+}
+
+void KMahjonggPrerenderer::clearCandidates()
+{
+    Q_D(KMahjonggPrerenderer);
+
+    d->candidates.clear();
+    d->candidateIndex = 0;
+    d->elementIndex = 0;
+}
+
+void KMahjonggPrerenderer::start()
+{
+    Q_D(KMahjonggPrerenderer);
+
+    d->candidateIndex = 0;
+    d->elementIndex = 0;
+    d->timer.start(0);
+}
+
+void KMahjonggPrerenderer::stop()
+{
+    Q_D(KMahjonggPrerenderer);
+
+    d->timer.stop();
+}
+
+bool KMahjonggPrerenderer::isActive() const
+{
+    Q_D(const KMahjonggPrerenderer);
+
+    return d->timer.isActive();
+}
+
+#include "moc_kmahjonggprerenderer.cpp"
@@ -0,0 +1,66 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef KMAHJONGGPRERENDERER_H
+#define KMAHJONGGPRERENDERER_H
+
+// Qt
+#include <QObject>
+#include <QSize>
+// Std
+#include <memory>
+
+// LibKMahjongg
+#include <libkmahjongg_export.h>
+
+class KMahjonggTileset;
+class KMahjonggPrerendererPrivate;
+
+/**
+ * @class KMahjonggPrerenderer kmahjonggprerenderer.h <KMahjonggPrerenderer>
+ *
+ * Renders the tiles of a tileset for sizes likely needed next, like those
+ * for a maximised or fullscreen window or another screen, while the application is idle.
+ *
+ * One element is rendered per event loop iteration, and rendering pauses
+ * for a moment whenever tiles or backgrounds had to be rendered for painting.
+ * Only the free room of the KMahjonggCache budgets is used, nothing cached gets evicted.
+ * Tiles are rendered for the device pixel ratio the pixmap getters of KMahjonggTileset use,
+ * the one of the application, as pixmaps for any other would never be asked for.
+ * To be used on the GUI thread.
+ */
+class LIBKMAHJONGG_EXPORT KMahjonggPrerenderer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit KMahjonggPrerenderer(KMahjonggTileset *tileset, QObject *parent = nullptr);
+    ~KMahjonggPrerenderer() override;
+
+    /// @param tileSize as passed to KMahjonggTileset::reloadTileset()
+    void addCandidate(QSize tileSize);
+    /// adds the tile size KMahjonggTileset::preferredTileSize() returns for the given board
+    void addBoardCandidate(QSize boardSize, int horizontalCells, int verticalCells);
+    /// adds board candidates for fullscreen and maximised windows on all screens
+    void addScreenCandidates(int horizontalCells, int verticalCells);
+    void clearCandidates();
+
+    /// (re)starts with the first candidate, e.g. after the tileset got changed
+    void start();
+    void stop();
+    bool isActive() const;
+
+Q_SIGNALS:
+    /// all candidates got rendered, as far as the budgets allowed
+    void finished();
+
+private:
+    std::unique_ptr<KMahjonggPrerendererPrivate> const d_ptr;
+    Q_DECLARE_PRIVATE(KMahjonggPrerenderer)
+    Q_DISABLE_COPY(KMahjonggPrerenderer)
+};
+
+#endif // KMAHJONGGPRERENDERER_H
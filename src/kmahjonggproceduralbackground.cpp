@@ -0,0 +1,239 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+// own
+#include "kmahjonggproceduralbackground_p.h"
+
+// Qt
+#include <QLinearGradient>
+#include <QPainter>
+#include <QRadialGradient>
+#include <QtMath>
+// Std
+#include <algorithm>
+#include <array>
+#include <vector>
+
+// KF
+#include <KConfigGroup>
+
+namespace
+{
+// noise patterns span this many grains in each direction before they repeat
+constexpr int noiseCellCount = 8;
+
+KMahjonggProceduralBackground::Kind kindFromName(const QString &name)
+{
+    if (name == QLatin1String("LinearGradient")) {
+        return KMahjonggProceduralBackground::LinearGradient;
+    }
+    if (name == QLatin1String("RadialGradient")) {
+        return KMahjonggProceduralBackground::RadialGradient;
+    }
+    if (name == QLatin1String("Stripes")) {
+        return KMahjonggProceduralBackground::Stripes;
+    }
+    if (name == QLatin1String("Checkerboard")) {
+        return KMahjonggProceduralBackground::Checkerboard;
+    }
+    if (name == QLatin1String("Noise")) {
+        return KMahjonggProceduralBackground::Noise;
+    }
+    return KMahjonggProceduralBackground::None;
+}
+
+// 0 to 255, the same for the same arguments on every platform
+int latticeValue(quint32 seed, int x, int y)
+{
+    quint32 hash = seed ^ (static_cast<quint32>(x) * 0x8da6b343u) ^ (static_cast<quint32>(y) * 0xd8163841u);
+    hash ^= hash >> 13;
+    hash *= 0x5bd1e995u;
+    hash ^= hash >> 15;
+    return static_cast<int>(hash & 0xff);
+}
+
+// per pixel along one axis of a noise pattern: the lattice cell and the 0 to 256 weight of the next one
+struct NoiseAxis {
+    std::vector<int> cells;
+    std::vector<int> weights;
+};
+
+NoiseAxis noiseAxis(int length)
+{
+    NoiseAxis axis;
+    axis.cells.resize(length);
+    axis.weights.resize(length);
+    for (int i = 0; i < length; ++i) {
+        const qreal position = static_cast<qreal>(i) * noiseCellCount / length;
+        const int cell = static_cast<int>(position);
+        const qreal fraction = position - cell;
+        // smoothstep, so the grain has no visible lattice lines
+        axis.cells[i] = cell;
+        axis.weights[i] = qRound(fraction * fraction * (3 - 2 * fraction) * 256);
+    }
+    return axis;
+}
+}
+
+KMahjonggProceduralBackground KMahjonggProceduralBackground::fromConfig(const KConfigGroup &group)
+{
+    KMahjonggProceduralBackground background;
+    background.color1 = group.readEntry("Color1", QColor());
+    background.color2 = group.readEntry("Color2", QColor());
+    if (!background.color1.isValid() || !background.color2.isValid()) {
+        return background;
+    }
+    background.angle = group.readEntry("Angle", 0.0);
+    background.scale = std::max(1, group.readEntry("Scale", 32));
+    background.seed = group.readEntry("Seed", 0u);
+    background.kind = kindFromName(group.readEntry("Procedure", QString()));
+    return background;
+}
+
+bool KMahjonggProceduralBackground::isTiled() const
+{
+    return kind == Checkerboard || kind == Noise;
+}
+
+QSize KMahjonggProceduralBackground::patternSize() const
+{
+    switch (kind) {
+    case Checkerboard:
+        return QSize(2 * scale, 2 * scale);
+    case Noise:
+        return QSize(noiseCellCount * scale, noiseCellCount * scale);
+    default:
+        return QSize();
+    }
+}
+
+bool KMahjonggProceduralBackground::hasNativeBrush() const
+{
+    return kind == LinearGradient || kind == RadialGradient || kind == Stripes;
+}
+
+QBrush KMahjonggProceduralBackground::nativeBrush() const
+{
+    const qreal radians = qDegreesToRadians(angle);
+    const QPointF direction(qCos(radians), qSin(radians));
+
+    switch (kind) {
+    case LinearGradient: {
+        // spans the painted area, whatever its size
+        QLinearGradient gradient(QPointF(0.5, 0.5) - direction / 2, QPointF(0.5, 0.5) + direction / 2);
+        gradient.setCoordinateMode(QGradient::StretchToDeviceMode);
+        gradient.setColorAt(0, color1);
+        gradient.setColorAt(1, color2);
+        return QBrush(gradient);
+    }
+    case RadialGradient: {
+        // reaching the corners
+        QRadialGradient gradient(QPointF(0.5, 0.5), M_SQRT1_2);
+        gradient.setCoordinateMode(QGradient::StretchToDeviceMode);
+        gradient.setColorAt(0, color1);
+        gradient.setColorAt(1, color2);
+        return QBrush(gradient);
+    }
+    case Stripes: {
+        // one period of both stripes, in logical pixels, repeated by QPainter itself
+        QLinearGradient gradient(QPointF(0, 0), direction * 2 * scale);
+        gradient.setSpread(QGradient::RepeatSpread);
+        gradient.setColorAt(0, color1);
+        gradient.setColorAt(0.499, color1);
+        gradient.setColorAt(0.5, color2);
+        gradient.setColorAt(1, color2);
+        return QBrush(gradient);
+    }
+    default:
+        return QBrush();
+    }
+}
+
+QImage KMahjonggProceduralBackground::render(QSize size, qreal dpr) const
+{
+    if (size.isEmpty()) {
+        return QImage();
+    }
+
+    switch (kind) {
+    case Checkerboard:
+        return renderCheckerboard(size);
+    case Noise:
+        return renderNoise(size);
+    default:
+        break;
+    }
+
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    if (hasNativeBrush()) {
+        // stripes are sized in logical pixels
+        image.setDevicePixelRatio(dpr);
+        QPainter painter(&image);
+        painter.fillRect(QRectF(QPointF(), QSizeF(size) / dpr), nativeBrush());
+        painter.end();
+        image.setDevicePixelRatio(1.0);
+    }
+    return image;
+}
+
+QImage KMahjonggProceduralBackground::renderCheckerboard(QSize size) const
+{
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    const QRgb first = qPremultiply(color1.rgba());
+    const QRgb second = qPremultiply(color2.rgba());
+    const int halfWidth = size.width() / 2;
+    const int halfHeight = size.height() / 2;
+
+    for (int y = 0; y < size.height(); ++y) {
+        auto *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+        const bool upper = (y < halfHeight);
+        std::fill(line, line + halfWidth, upper ? first : second);
+        std::fill(line + halfWidth, line + size.width(), upper ? second : first);
+    }
+    return image;
+}
+
+QImage KMahjonggProceduralBackground::renderNoise(QSize size) const
+{
+    // the lattice wraps around, so the pattern repeats seamlessly
+    std::array<std::array<int, noiseCellCount + 1>, noiseCellCount + 1> lattice;
+    for (int y = 0; y <= noiseCellCount; ++y) {
+        for (int x = 0; x <= noiseCellCount; ++x) {
+            lattice[y][x] = latticeValue(seed, x % noiseCellCount, y % noiseCellCount);
+        }
+    }
+
+    std::array<QRgb, 256> palette;
+    for (int value = 0; value < 256; ++value) {
+        const qreal t = value / 255.0;
+        const QColor color = QColor::fromRgbF(color1.redF() + (color2.redF() - color1.redF()) * t,
+                                              color1.greenF() + (color2.greenF() - color1.greenF()) * t,
+                                              color1.blueF() + (color2.blueF() - color1.blueF()) * t,
+                                              color1.alphaF() + (color2.alphaF() - color1.alphaF()) * t);
+        palette[value] = qPremultiply(color.rgba());
+    }
+
+    const NoiseAxis columns = noiseAxis(size.width());
+    const NoiseAxis rows = noiseAxis(size.height());
+
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < size.height(); ++y) {
+        auto *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+        const auto &top = lattice[rows.cells[y]];
+        const auto &bottom = lattice[rows.cells[y] + 1];
+        const int yWeight = rows.weights[y];
+        for (int x = 0; x < size.width(); ++x) {
+            const int cell = columns.cells[x];
+            const int xWeight = columns.weights[x];
+            // fixed point bilinear interpolation, 8 fractional bits per axis
+            const int upper = top[cell] * (256 - xWeight) + top[cell + 1] * xWeight;
+            const int lower = bottom[cell] * (256 - xWeight) + bottom[cell + 1] * xWeight;
+            line[x] = palette[(upper * (256 - yWeight) + lower * yWeight) >> 16];
+        }
+    }
+    return image;
+}
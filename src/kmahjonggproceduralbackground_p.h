@@ -0,0 +1,76 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef KMAHJONGGPROCEDURALBACKGROUND_P_H
+#define KMAHJONGGPROCEDURALBACKGROUND_P_H
+
+// Qt
+#include <QBrush>
+#include <QColor>
+#include <QImage>
+#include <QSize>
+
+class KConfigGroup;
+
+/**
+ * Background generated from a few parameters of its .desktop file, without any SVG.
+ *
+ * Declared with Type=Procedural and these entries:
+ * - Procedure: LinearGradient, RadialGradient, Stripes, Checkerboard or Noise
+ * - Color1, Color2: the colours blended or alternated
+ * - Angle: direction in degrees of LinearGradient and Stripes, 0 by default
+ * - Scale: in logical pixels, the width of a stripe, a checkerboard square
+ *   or a noise grain, 32 by default
+ * - Seed: of Noise, 0 by default
+ *
+ * Gradients and stripes are native QGradient brushes, drawn by QPainter without any image.
+ * Checkerboard and Noise are small tileable patterns, written straight into the image memory.
+ */
+class KMahjonggProceduralBackground
+{
+public:
+    enum Kind {
+        None,
+        LinearGradient,
+        RadialGradient,
+        Stripes,
+        Checkerboard,
+        Noise,
+    };
+
+    /// None, if the entries are missing or invalid
+    static KMahjonggProceduralBackground fromConfig(const KConfigGroup &group);
+
+    bool isValid() const
+    {
+        return kind != None;
+    }
+
+    /// if true, the background repeats a pattern of patternSize(), otherwise it is made for the whole area
+    bool isTiled() const;
+    /// in logical pixels
+    QSize patternSize() const;
+
+    bool hasNativeBrush() const;
+    QBrush nativeBrush() const;
+
+    /// image of exactly @p size device pixels, itself with a device pixel ratio of 1
+    QImage render(QSize size, qreal dpr) const;
+
+public:
+    Kind kind = None;
+    QColor color1;
+    QColor color2;
+    qreal angle = 0;
+    int scale = 32;
+    quint32 seed = 0;
+
+private:
+    QImage renderCheckerboard(QSize size) const;
+    QImage renderNoise(QSize size) const;
+};
+
+#endif // KMAHJONGGPROCEDURALBACKGROUND_P_H
@@ -0,0 +1,237 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+// own
+#include "kmahjonggrenderqueue.h"
+
+// Qt
+#include <QElapsedTimer>
+#include <QList>
+#include <QTimer>
+// Std
+#include <algorithm>
+
+// LibKMahjongg
+#include "kmahjonggbackground.h"
+#include "kmahjonggtileelements_p.h"
+
+class KMahjonggRenderQueuePrivate
+{
+public:
+    KMahjonggRenderQueuePrivate(KMahjonggTileset *tileset, KMahjonggBackground *background)
+        : tileset(tileset)
+        , background(background)
+    {
+    }
+
+    struct Item {
+        enum Kind {
+            UnselectedTile,
+            SelectedTile,
+            Tileface,
+            Background,
+        };
+
+        Kind kind;
+        int number;
+        KMahjonggTileset::Rotation rotation;
+
+        bool operator==(const Item &other) const
+        {
+            return kind == other.kind && number == other.number && rotation == other.rotation;
+        }
+    };
+
+    void enqueue(const Item &item, KMahjonggRenderQueue::Priority priority);
+    void render(const Item &item) const;
+
+public:
+    KMahjonggTileset *const tileset;
+    KMahjonggBackground *const background;
+    // rendered first to last, the visible ones before all others
+    QList<Item> visibleItems;
+    QList<Item> offscreenItems;
+    int budget = 4;
+    QTimer timer;
+};
+
+void KMahjonggRenderQueuePrivate::enqueue(const Item &item, KMahjonggRenderQueue::Priority priority)
+{
+    if (priority == KMahjonggRenderQueue::Visible) {
+        // promoted if queued as offscreen before
+        offscreenItems.removeOne(item);
+        if (!visibleItems.contains(item)) {
+            visibleItems.append(item);
+        }
+    } else if (!visibleItems.contains(item) && !offscreenItems.contains(item)) {
+        offscreenItems.append(item);
+    }
+    timer.start(0);
+}
+
+void KMahjonggRenderQueuePrivate::render(const Item &item) const
+{
+    // the getters render into the pixmap caches, where painting picks the results up
+    switch (item.kind) {
+    case Item::UnselectedTile:
+        if (tileset) {
+            tileset->unselectedTile(item.number, item.rotation);
+        }
+        break;
+    case Item::SelectedTile:
+        if (tileset) {
+            tileset->selectedTile(item.number, item.rotation);
+        }
+        break;
+    case Item::Tileface:
+        if (tileset) {
+            tileset->tileface(item.number, item.rotation);
+        }
+        break;
+    case Item::Background:
+        if (background) {
+            background->getBackground();
+        }
+        break;
+    }
+}
+
+KMahjonggRenderQueue::KMahjonggRenderQueue(KMahjonggTileset *tileset, KMahjonggBackground *background, QObject *parent)
+    : QObject(parent)
+    , d_ptr(new KMahjonggRenderQueuePrivate(tileset, background))
+{
+    Q_D(KMahjonggRenderQueue);
+
+    d->timer.setSingleShot(true);
+
+    connect(&d->timer, &QTimer::timeout, this, [this]() {
+        Q_D(KMahjonggRenderQueue);
+
+        QElapsedTimer slice;
+        slice.start();
+        // at least one element per slice, so a tiny budget still makes progress
+        do {
+            QList<KMahjonggRenderQueuePrivate::Item> &items = d->visibleItems.isEmpty() ? d->offscreenItems : d->visibleItems;
+            if (items.isEmpty()) {
+                break;
+            }
+            d->render(items.takeFirst());
+        } while (slice.elapsed() < d->budget);
+
+        Q_EMIT elementsRendered();
+        if (d->visibleItems.isEmpty() && d->offscreenItems.isEmpty()) {
+            Q_EMIT finished();
+            return;
+        }
+        // back to the event loop, so painting and input get their turn
+        d->timer.start(0);
+    });
+}
+
+KMahjonggRenderQueue::~KMahjonggRenderQueue() = default;
+
+void KMahjonggRenderQueue::setBudget(int msecs)
+{
+    Q_D(KMahjonggRenderQueue);
+
+    d->budget = std::max(0, msecs);
+}
+
+int KMahjonggRenderQueue::budget() const
+{
+    Q_D(const KMahjonggRenderQueue);
+
+    return d->budget;
+}
+
+void KMahjonggRenderQueue::enqueueTile(int num, bool selected, Priority priority, KMahjonggTileset::Rotation rotation)
+{
+    Q_D(KMahjonggRenderQueue);
+
+    const auto kind = selected ? KMahjonggRenderQueuePrivate::Item::SelectedTile : KMahjonggRenderQueuePrivate::Item::UnselectedTile;
+    d->enqueue({kind, num, rotation}, priority);
+}
+
+void KMahjonggRenderQueue::enqueueTileface(int face, Priority priority, KMahjonggTileset::Rotation rotation)
+{
+    Q_D(KMahjonggRenderQueue);
+
+    d->enqueue({KMahjonggRenderQueuePrivate::Item::Tileface, face, rotation}, priority);
+}
+
+void KMahjonggRenderQueue::enqueueBackground(Priority priority)
+{
+    Q_D(KMahjonggRenderQueue);
+
+    d->enqueue({KMahjonggRenderQueuePrivate::Item::Background, 0, KMahjonggTileset::Rotate0}, priority);
+}
+
+void KMahjonggRenderQueue::enqueueAll()
+{
+    // the background fills the whole window, then bodies, which are part of every tile
+    enqueueBackground(Offscreen);
+    for (int num = 0; num < KMahjonggTileset::BodyCount; ++num) {
+        enqueueTile(num, false, Offscreen);
+    }
+    for (int face = 0; face < KMahjonggTileset::FaceCount; ++face) {
+        enqueueTileface(face, Offscreen);
+    }
+    for (int num = 0; num < KMahjonggTileset::BodyCount; ++num) {
+        enqueueTile(num, true, Offscreen);
+    }
+}
+
+void KMahjonggRenderQueue::clear()
+{
+    Q_D(KMahjonggRenderQueue);
+
+    d->timer.stop();
+    d->visibleItems.clear();
+    d->offscreenItems.clear();
+}
+
+int KMahjonggRenderQueue::pendingCount() const
+{
+    Q_D(const KMahjonggRenderQueue);
+
+    return d->visibleItems.size() + d->offscreenItems.size();
+}
+
+bool KMahjonggRenderQueue::isActive() const
+{
+    Q_D(const KMahjonggRenderQueue);
+
+    return d->timer.isActive();
+}
+
+QPixmap KMahjonggRenderQueue::cachedTile(int num, bool selected, KMahjonggTileset::Rotation rotation) const
+{
+    Q_D(const KMahjonggRenderQueue);
+
+    if (!d->tileset || !KMahjonggTileElements::isValidBody(num)) {
+        return QPixmap();
+    }
+    return d->tileset->cachedElement(selected ? KMahjonggTileElements::selectedIndex(num) : num, rotation);
+}
+
+QPixmap KMahjonggRenderQueue::cachedTileface(int face, KMahjonggTileset::Rotation rotation) const
+{
+    Q_D(const KMahjonggRenderQueue);
+
+    if (!d->tileset || !KMahjonggTileElements::isValidFace(face)) {
+        return QPixmap();
+    }
+    return d->tileset->cachedElement(KMahjonggTileElements::faceIndex(face), rotation);
+}
+
+bool KMahjonggRenderQueue::isBackgroundReady() const
+{
+    Q_D(const KMahjonggRenderQueue);
+
+    return d->background && d->background->isRendered();
+}
+
+#include "moc_kmahjonggrenderqueue.cpp"
@@ -0,0 +1,102 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef KMAHJONGGRENDERQUEUE_H
+#define KMAHJONGGRENDERQUEUE_H
+
+// Qt
+#include <QObject>
+// Std
+#include <memory>
+
+// LibKMahjongg
+#include "kmahjonggtileset.h"
+#include <libkmahjongg_export.h>
+
+class KMahjonggBackground;
+class KMahjonggRenderQueuePrivate;
+
+/**
+ * @class KMahjonggRenderQueue kmahjonggrenderqueue.h <KMahjonggRenderQueue>
+ *
+ * Renders the elements of a tileset and a background in time slices, for hosts without worker threads.
+ *
+ * Queued elements are rendered at the current size of the tileset, resp. background,
+ * into the pixmap caches. Per event loop iteration rendering stops once the budget is used up,
+ * so no frame gets delayed by much more than that, even right after switching the tileset.
+ * Visible elements are rendered before offscreen ones.
+ *
+ * The budget only holds if painting never renders itself. The pixmap getters of
+ * KMahjonggTileset and KMahjonggBackground render anything missing on the spot,
+ * so hosts should paint with cachedTile() and cachedTileface() instead, which never
+ * render, and draw a placeholder for a null pixmap until elementsRendered() comes.
+ * To be used on the GUI thread.
+ * @code
+ * tileset.reloadTileset(tileSize);
+ * queue->enqueueAll();
+ * for (const Tile &tile : visibleTiles) {
+ *     queue->enqueueTileface(tile.face, KMahjonggRenderQueue::Visible);
+ * }
+ * // in paint(), repeated on elementsRendered()
+ * const QPixmap face = queue->cachedTileface(tile.face);
+ * if (face.isNull()) {
+ *     painter->fillRect(faceRect, placeholderColor);
+ * } else {
+ *     painter->drawPixmap(faceRect.topLeft(), face);
+ * }
+ * @endcode
+ */
+class LIBKMAHJONGG_EXPORT KMahjonggRenderQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Priority {
+        Visible,
+        Offscreen,
+    };
+
+    /// neither is owned, both may be nullptr
+    explicit KMahjonggRenderQueue(KMahjonggTileset *tileset, KMahjonggBackground *background, QObject *parent = nullptr);
+    ~KMahjonggRenderQueue() override;
+
+    /// maximum time in milliseconds spent rendering per event loop iteration, 4 by default
+    void setBudget(int msecs);
+    int budget() const;
+
+    void enqueueTile(int num, bool selected, Priority priority = Visible, KMahjonggTileset::Rotation rotation = KMahjonggTileset::Rotate0);
+    void enqueueTileface(int face, Priority priority = Visible, KMahjonggTileset::Rotation rotation = KMahjonggTileset::Rotate0);
+    void enqueueBackground(Priority priority = Visible);
+    /// queues all upright elements and the background as offscreen, e.g. after a tileset switch or resize
+    void enqueueAll();
+    void clear();
+
+    int pendingCount() const;
+    bool isActive() const;
+
+    /**
+     * The pixmap if already rendered at the current size, a null pixmap otherwise.
+     * Never renders, so safe to call while painting. Has no effect on the pixmap caches,
+     * compressed entries count as missing until an enqueued element restores them.
+     */
+    QPixmap cachedTile(int num, bool selected, KMahjonggTileset::Rotation rotation = KMahjonggTileset::Rotate0) const;
+    QPixmap cachedTileface(int face, KMahjonggTileset::Rotation rotation = KMahjonggTileset::Rotate0) const;
+    /// whether KMahjonggBackground::getBackground() would return without rendering
+    bool isBackgroundReady() const;
+
+Q_SIGNALS:
+    /// some elements got rendered in the last slice
+    void elementsRendered();
+    /// the queue got empty
+    void finished();
+
+private:
+    std::unique_ptr<KMahjonggRenderQueuePrivate> const d_ptr;
+    Q_DECLARE_PRIVATE(KMahjonggRenderQueue)
+    Q_DISABLE_COPY(KMahjonggRenderQueue)
+};
+
+#endif // KMAHJONGGRENDERQUEUE_H
@@ -0,0 +1,175 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef KMAHJONGGSNAPSHOTCACHE_P_H
+#define KMAHJONGGSNAPSHOTCACHE_P_H
+
+// Qt
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QString>
+// Std
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * Cache for the images rendered by the thread-safe getters, readable without locks.
+ *
+ * Readers look up an immutable snapshot of the whole cache, published atomically.
+ * Writers copy the current snapshot, change the copy and publish it in its place,
+ * so they never block readers, only each other. As the caches are cleared on every
+ * resize and hold at most a couple of scales, a snapshot only ever holds a few hundred
+ * entries, cheap to copy.
+ *
+ * Each reader announces the snapshot it uses in a slot of its own, so readers on
+ * different threads touch no shared cache line but the one of the snapshot pointer.
+ * Writers delete every replaced snapshot not announced in any slot, so at most one
+ * replaced snapshot per reader in progress is kept alive.
+ */
+template<typename T>
+class KMahjonggSnapshotCache
+{
+public:
+    using Snapshot = QHash<QString, T>;
+
+    KMahjonggSnapshotCache()
+        : current(new Snapshot)
+    {
+    }
+
+    ~KMahjonggSnapshotCache()
+    {
+        delete current.load();
+    }
+
+    bool find(const QString &key, T *value) const
+    {
+        std::atomic<const Snapshot *> *slot = nullptr;
+        const Snapshot *snapshot = acquire(&slot);
+        const auto it = snapshot->constFind(key);
+        const bool found = (it != snapshot->constEnd());
+        if (found) {
+            *value = it.value();
+        }
+        slot->store(nullptr, std::memory_order_release);
+        return found;
+    }
+
+    T value(const QString &key) const
+    {
+        T result;
+        find(key, &result);
+        return result;
+    }
+
+    void insert(const QString &key, const T &value)
+    {
+        const QMutexLocker locker(&writeMutex);
+
+        auto next = std::make_unique<Snapshot>(*current.load());
+        next->insert(key, value);
+        publish(std::move(next));
+    }
+
+    void remove(const QString &key)
+    {
+        removeIf([&key](const QString &entryKey) {
+            return entryKey == key;
+        });
+    }
+
+    template<typename Predicate>
+    void removeIf(Predicate predicate)
+    {
+        const QMutexLocker locker(&writeMutex);
+
+        auto next = std::make_unique<Snapshot>(*current.load());
+        const qsizetype removed = next->removeIf([&predicate](const typename Snapshot::iterator &it) {
+            return predicate(it.key());
+        });
+        if (removed > 0) {
+            publish(std::move(next));
+        }
+    }
+
+    void clear()
+    {
+        const QMutexLocker locker(&writeMutex);
+
+        if (!current.load()->isEmpty()) {
+            publish(std::make_unique<Snapshot>());
+        }
+    }
+
+private:
+    // more concurrent readers than slots have to wait for a free one
+    static constexpr int SlotCount = 64;
+
+    struct alignas(64) ReaderSlot {
+        // snapshot in use by the reader owning the slot, nullptr if free
+        std::atomic<const Snapshot *> snapshot{nullptr};
+    };
+
+    // spreads the threads over the slots, so a thread usually finds its own slot free
+    static int homeSlot()
+    {
+        static std::atomic<int> threadCount{0};
+        thread_local const int slot = threadCount.fetch_add(1, std::memory_order_relaxed) % SlotCount;
+        return slot;
+    }
+
+    // claims a free slot and announces the current snapshot in it
+    const Snapshot *acquire(std::atomic<const Snapshot *> **slot) const
+    {
+        const Snapshot *snapshot = current.load();
+        for (int index = homeSlot();; index = (index + 1) % SlotCount) {
+            std::atomic<const Snapshot *> &candidate = readerSlots[index].snapshot;
+            const Snapshot *expected = nullptr;
+            if (!candidate.compare_exchange_strong(expected, snapshot)) {
+                continue;
+            }
+            // The snapshot may have been replaced before it was announced, and so be
+            // missed by the writer, see publish(). Only a still current one is safe.
+            for (const Snapshot *latest = current.load(); latest != snapshot; latest = current.load()) {
+                snapshot = latest;
+                candidate.store(snapshot);
+            }
+            *slot = &candidate;
+            return snapshot;
+        }
+    }
+
+    // to be called with writeMutex locked
+    void publish(std::unique_ptr<Snapshot> next)
+    {
+        retired.emplace_back(current.exchange(next.release()));
+        // A reader announces its snapshot before checking it is still current,
+        // so with sequentially consistent ordering every reader that can still
+        // use a replaced snapshot shows up in the slots here.
+        std::array<const Snapshot *, SlotCount> inUse;
+        for (int index = 0; index < SlotCount; ++index) {
+            inUse[index] = readerSlots[index].snapshot.load();
+        }
+        std::erase_if(retired, [&inUse](const std::unique_ptr<Snapshot> &snapshot) {
+            return std::find(inUse.cbegin(), inUse.cend(), snapshot.get()) == inUse.cend();
+        });
+    }
+
+private:
+    std::atomic<Snapshot *> current;
+    mutable std::array<ReaderSlot, SlotCount> readerSlots;
+    QMutex writeMutex;
+    // replaced snapshots a reader might still use, guarded by writeMutex
+    std::vector<std::unique_ptr<Snapshot>> retired;
+
+    Q_DISABLE_COPY(KMahjonggSnapshotCache)
+};
+
+#endif // KMAHJONGGSNAPSHOTCACHE_P_H
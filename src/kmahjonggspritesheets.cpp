@@ -0,0 +1,157 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+// own
+#include "kmahjonggspritesheets_p.h"
+
+// Qt
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+
+// LibKMahjongg
+#include "libkmahjongg_debug.h"
+
+// Std
+#include <algorithm>
+
+bool KMahjonggSpriteSheets::load(const QString &indexFileName, const QStringList &elementIds)
+{
+    clear();
+
+    QFile indexFile(indexFileName);
+    if (!indexFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const QJsonObject index = QJsonDocument::fromJson(indexFile.readAll()).object();
+    if (index.value(QLatin1String("version")).toInt() != 1) {
+        qCWarning(LIBKMAHJONGG_LOG) << "Unsupported sprite sheet index" << indexFileName;
+        return false;
+    }
+
+    const QString dir = QFileInfo(indexFileName).absolutePath() + QLatin1Char('/');
+    std::vector<Sheet> sheets;
+    const QJsonArray sheetArray = index.value(QLatin1String("sheets")).toArray();
+    for (const QJsonValue &sheetValue : sheetArray) {
+        const QJsonObject sheetObject = sheetValue.toObject();
+        const QJsonObject elements = sheetObject.value(QLatin1String("elements")).toObject();
+        Sheet sheet;
+        sheet.fileName = dir + sheetObject.value(QLatin1String("file")).toString();
+        for (const QString &elementId : elementIds) {
+            const QJsonArray rect = elements.value(elementId).toArray();
+            if (rect.size() != 4) {
+                qCWarning(LIBKMAHJONGG_LOG) << "Sprite sheet" << sheet.fileName << "misses element" << elementId;
+                return false;
+            }
+            sheet.rects.insert(elementId, QRect(rect.at(0).toInt(), rect.at(1).toInt(), rect.at(2).toInt(), rect.at(3).toInt()));
+        }
+        sheets.push_back(std::move(sheet));
+    }
+    if (sheets.empty() || elementIds.isEmpty()) {
+        return false;
+    }
+
+    const QString &referenceId = elementIds.first();
+    std::sort(sheets.begin(), sheets.end(), [&referenceId](const Sheet &a, const Sheet &b) {
+        return a.rects.value(referenceId).width() > b.rects.value(referenceId).width();
+    });
+
+    const QJsonObject elements = index.value(QLatin1String("elements")).toObject();
+    for (const QString &elementId : elementIds) {
+        const QString hash = elements.value(elementId).toObject().value(QLatin1String("hash")).toString();
+        if (!hash.isEmpty()) {
+            m_elementHashes.insert(elementId, hash.toLatin1());
+        }
+    }
+
+    auto sheetSet = std::make_shared<SheetSet>();
+    sheetSet->images = std::vector<SheetImage>(sheets.size());
+    sheetSet->sheets = std::move(sheets);
+
+    m_fileName = indexFileName;
+    const QMutexLocker locker(&m_mutex);
+    m_sheetSet = std::move(sheetSet);
+    return true;
+}
+
+void KMahjonggSpriteSheets::clear()
+{
+    m_fileName.clear();
+    m_elementHashes.clear();
+    const QMutexLocker locker(&m_mutex);
+    m_sheetSet.reset();
+}
+
+bool KMahjonggSpriteSheets::isValid() const
+{
+    return static_cast<bool>(sheetSet());
+}
+
+std::shared_ptr<KMahjonggSpriteSheets::SheetSet> KMahjonggSpriteSheets::sheetSet() const
+{
+    const QMutexLocker locker(&m_mutex);
+    return m_sheetSet;
+}
+
+QString KMahjonggSpriteSheets::fileName() const
+{
+    return m_fileName;
+}
+
+QHash<QString, QByteArray> KMahjonggSpriteSheets::elementHashes() const
+{
+    return m_elementHashes;
+}
+
+int KMahjonggSpriteSheets::closestSheet(const SheetSet &sheetSet, const QString &elementId, QSize size)
+{
+    // downsampling from the next larger resolution keeps the most detail,
+    // at most by half, as the resolutions are halved from sheet to sheet
+    for (int sheet = static_cast<int>(sheetSet.sheets.size()) - 1; sheet >= 0; --sheet) {
+        const QSize sheetSize = sheetSet.sheets[sheet].rects.value(elementId).size();
+        if (sheetSize.width() >= size.width() && sheetSize.height() >= size.height()) {
+            return sheet;
+        }
+    }
+    return 0;
+}
+
+QImage KMahjonggSpriteSheets::sheetImage(SheetSet &sheetSet, int sheet)
+{
+    // decoded outside of m_mutex, so only renderings of this very sheet wait for it
+    SheetImage &sheetImage = sheetSet.images[sheet];
+    std::call_once(sheetImage.read, [&sheetImage, &fileName = sheetSet.sheets[sheet].fileName]() {
+        sheetImage.image = QImage(fileName).convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        if (sheetImage.image.isNull()) {
+            qCWarning(LIBKMAHJONGG_LOG) << "Could not read sprite sheet" << fileName;
+        }
+    });
+    return sheetImage.image;
+}
+
+QImage KMahjonggSpriteSheets::render(const QString &elementId, QSize size) const
+{
+    // kept alive even if load() or clear() replace the sheets meanwhile
+    const std::shared_ptr<SheetSet> sheets = sheetSet();
+    if (!sheets || size.isEmpty()) {
+        return QImage();
+    }
+
+    const int sheet = closestSheet(*sheets, elementId, size);
+    const QImage image = sheetImage(*sheets, sheet);
+    if (image.isNull()) {
+        return QImage();
+    }
+
+    const QImage sprite = image.copy(sheets->sheets[sheet].rects.value(elementId));
+    if (sprite.size() == size) {
+        return sprite;
+    }
+    return sprite.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+}
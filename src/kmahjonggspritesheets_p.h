@@ -0,0 +1,81 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef KMAHJONGGSPRITESHEETS_P_H
+#define KMAHJONGGSPRITESHEETS_P_H
+
+// Qt
+#include <QByteArray>
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QRect>
+#include <QString>
+#include <QStringList>
+// Std
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * Pre-rasterised tileset graphics, as generated by kmahjonggspritesheet.
+ *
+ * An index file in JSON lists the sheets, each with all elements rendered
+ * at one resolution, halved from sheet to sheet:
+ * @code
+ * {"version": 1,
+ *  "elements": {"TILE_1": {"hash": "..."}, ...},
+ *  "sheets": [{"file": "name.0.png", "elements": {"TILE_1": [x, y, w, h], ...}}, ...]}
+ * @endcode
+ * The sheet images are only read when first needed.
+ * render() may be called from any thread concurrently, also while load() or clear()
+ * replace the sheets, in which case it still uses the ones it started with.
+ */
+class KMahjonggSpriteSheets
+{
+public:
+    /// reads the index, fails if any of @p elementIds is missing in any sheet
+    bool load(const QString &indexFileName, const QStringList &elementIds);
+    void clear();
+    bool isValid() const;
+    QString fileName() const;
+    /// hashes of the elements in the source SVG, to key caches with
+    QHash<QString, QByteArray> elementHashes() const;
+
+    /// @return the element from the sheet with the closest larger resolution, resampled to @p size
+    QImage render(const QString &elementId, QSize size) const;
+
+private:
+    struct Sheet {
+        QString fileName;
+        QHash<QString, QRect> rects;
+    };
+
+    // read on first use, by the first thread needing it, without blocking the others
+    struct SheetImage {
+        std::once_flag read;
+        QImage image;
+    };
+
+    // replaced as a whole, never changed once published but for the images read
+    struct SheetSet {
+        std::vector<Sheet> sheets; // largest resolution first
+        std::vector<SheetImage> images; // matching sheets
+    };
+
+    std::shared_ptr<SheetSet> sheetSet() const;
+    static int closestSheet(const SheetSet &sheetSet, const QString &elementId, QSize size);
+    static QImage sheetImage(SheetSet &sheetSet, int sheet);
+
+private:
+    QString m_fileName;
+    QHash<QString, QByteArray> m_elementHashes;
+
+    mutable QMutex m_mutex;
+    std::shared_ptr<SheetSet> m_sheetSet; // guarded by m_mutex, null if nothing is loaded
+};
+
+#endif // KMAHJONGGSPRITESHEETS_P_H
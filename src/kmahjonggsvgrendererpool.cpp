@@ -0,0 +1,143 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+// own
+#include "kmahjonggsvgrendererpool_p.h"
+
+// Qt
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSvgRenderer>
+
+namespace
+{
+QString preferredSourceFile(const QString &fileName)
+{
+    // installations can ship the uncompressed variant as well, see INSTALL_UNCOMPRESSED_SVG
+    if (fileName.endsWith(QLatin1String(".svgz"))) {
+        const QString uncompressedFileName = fileName.chopped(1);
+        if (QFileInfo::exists(uncompressedFileName)) {
+            return uncompressedFileName;
+        }
+    }
+    return fileName;
+}
+}
+
+KMahjonggSvgRendererPool::KMahjonggSvgRendererPool() = default;
+
+KMahjonggSvgRendererPool::~KMahjonggSvgRendererPool() = default;
+
+bool KMahjonggSvgRendererPool::load(const QString &fileName)
+{
+    clear();
+
+    const QString sourceFileName = preferredSourceFile(fileName);
+    // read once, further renderers are parsed from memory
+    // not mapped, as an editor truncating the file in place would crash parsers still reading the pages
+    QFile file(sourceFileName);
+    QByteArray data;
+    if (file.open(QIODevice::ReadOnly)) {
+        data = file.readAll();
+    }
+
+    auto renderer = createRenderer(sourceFileName, data);
+    if (!renderer->isValid()) {
+        return false;
+    }
+
+    const QMutexLocker locker(&m_mutex);
+    m_fileName = sourceFileName;
+    m_data = data;
+    m_isValid = true;
+    ++m_generation;
+    m_idleRenderers.push_back(std::move(renderer));
+    return true;
+}
+
+void KMahjonggSvgRendererPool::clear()
+{
+    const QMutexLocker locker(&m_mutex);
+    m_idleRenderers.clear();
+    m_fileName.clear();
+    // parsers still holding a copy keep it alive
+    m_data = QByteArray();
+    m_isValid = false;
+    ++m_generation;
+}
+
+bool KMahjonggSvgRendererPool::isValid() const
+{
+    return m_isValid;
+}
+
+QString KMahjonggSvgRendererPool::fileName() const
+{
+    const QMutexLocker locker(&m_mutex);
+    return m_fileName;
+}
+
+std::unique_ptr<QSvgRenderer> KMahjonggSvgRendererPool::createRenderer(const QString &fileName, const QByteArray &data)
+{
+    if (data.isNull()) {
+        return std::make_unique<QSvgRenderer>(fileName);
+    }
+    // also inflates the data if compressed
+    auto renderer = std::make_unique<QSvgRenderer>();
+    renderer->load(data);
+    return renderer;
+}
+
+std::unique_ptr<QSvgRenderer> KMahjonggSvgRendererPool::acquire(quint64 *generation) const
+{
+    QString fileName;
+    QByteArray data;
+    {
+        const QMutexLocker locker(&m_mutex);
+        *generation = m_generation;
+        if (!m_idleRenderers.empty()) {
+            std::unique_ptr<QSvgRenderer> renderer = std::move(m_idleRenderers.back());
+            m_idleRenderers.pop_back();
+            return renderer;
+        }
+        fileName = m_fileName;
+        data = m_data;
+    }
+
+    // all renderers are busy, parse another one without holding the lock
+    return createRenderer(fileName, data);
+}
+
+void KMahjonggSvgRendererPool::release(std::unique_ptr<QSvgRenderer> renderer, quint64 generation) const
+{
+    const QMutexLocker locker(&m_mutex);
+    // drop renderers of a file which got replaced meanwhile
+    if (generation != m_generation) {
+        return;
+    }
+    m_idleRenderers.push_back(std::move(renderer));
+}
+
+void KMahjonggSvgRendererPool::render(QPainter *painter, const QString &elementId, const QRectF &bounds) const
+{
+    if (!m_isValid) {
+        return;
+    }
+
+    quint64 generation;
+    std::unique_ptr<QSvgRenderer> renderer = acquire(&generation);
+    if (elementId.isEmpty()) {
+        if (bounds.isNull()) {
+            renderer->render(painter);
+        } else {
+            renderer->render(painter, bounds);
+        }
+    } else {
+        renderer->render(painter, elementId, bounds);
+    }
+    release(std::move(renderer), generation);
+}
@@ -0,0 +1,61 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef KMAHJONGGSVGRENDERERPOOL_P_H
+#define KMAHJONGGSVGRENDERERPOOL_P_H
+
+// Qt
+#include <QByteArray>
+#include <QMutex>
+#include <QRectF>
+#include <QString>
+// Std
+#include <memory>
+#include <vector>
+
+class QPainter;
+class QSvgRenderer;
+
+/**
+ * Set of QSvgRenderer instances for the same SVG file.
+ *
+ * QSvgRenderer::render() is not reentrant, so each rendering call leases
+ * a renderer for its own exclusive use. Further renderers are loaded on demand,
+ * so threads rendering concurrently do not wait for each other.
+ *
+ * The file is read once and all renderers are parsed from that data.
+ * An uncompressed .svg next to a requested .svgz file is preferred, as it needs no inflating.
+ */
+class KMahjonggSvgRendererPool
+{
+public:
+    KMahjonggSvgRendererPool();
+    ~KMahjonggSvgRendererPool();
+
+    bool load(const QString &fileName);
+    void clear();
+    bool isValid() const;
+    /// the file actually loaded, which might be the uncompressed variant of the one passed to load()
+    QString fileName() const;
+
+    /// renders into @p bounds, or the whole paint device if @p bounds is null
+    void render(QPainter *painter, const QString &elementId = QString(), const QRectF &bounds = QRectF()) const;
+
+private:
+    static std::unique_ptr<QSvgRenderer> createRenderer(const QString &fileName, const QByteArray &data);
+    std::unique_ptr<QSvgRenderer> acquire(quint64 *generation) const;
+    void release(std::unique_ptr<QSvgRenderer> renderer, quint64 generation) const;
+
+private:
+    mutable QMutex m_mutex;
+    mutable std::vector<std::unique_ptr<QSvgRenderer>> m_idleRenderers;
+    QString m_fileName;
+    QByteArray m_data; // content of the file, null if reading failed
+    quint64 m_generation = 0; // increased with every load() or clear()
+    bool m_isValid = false;
+};
+
+#endif // KMAHJONGGSVGRENDERERPOOL_P_H
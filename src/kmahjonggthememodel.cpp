@@ -0,0 +1,231 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+// own
+#include "kmahjonggthememodel_p.h"
+
+// Qt
+#include <QDir>
+#include <QStandardPaths>
+#include <QTimer>
+
+// LibKMahjongg
+#include "kmahjonggbackground.h"
+#include "kmahjonggtileset.h"
+
+// Std
+#include <algorithm>
+
+KMahjonggThemeModel::KMahjonggThemeModel(Kind kind, QObject *parent)
+    : QAbstractListModel(parent)
+    , m_kind(kind)
+{
+    const QString subDir = (kind == Tilesets) ? QStringLiteral("kmahjongglib/tilesets") : QStringLiteral("kmahjongglib/backgrounds");
+    const QStringList dirs = QStandardPaths::locateAll(QStandardPaths::GenericDataLocation, subDir, QStandardPaths::LocateDirectory);
+    for (const QString &dir : dirs) {
+        const QStringList fileNames = QDir(dir).entryList({QStringLiteral("*.desktop")});
+        for (const QString &file : fileNames) {
+            Theme theme;
+            theme.path = dir + QLatin1Char('/') + file;
+            m_themes.push_back(std::move(theme));
+        }
+    }
+}
+
+KMahjonggThemeModel::~KMahjonggThemeModel() = default;
+
+int KMahjonggThemeModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+    return static_cast<int>(m_themes.size());
+}
+
+QVariant KMahjonggThemeModel::data(const QModelIndex &index, int role) const
+{
+    if (!checkIndex(index, CheckIndexOption::IndexIsValid)) {
+        return {};
+    }
+
+    Theme &theme = m_themes[index.row()];
+    if (role == PathRole) {
+        return theme.path;
+    }
+
+    ensureMetadata(theme);
+    switch (role) {
+    case Qt::DisplayRole:
+        return theme.name;
+    case Qt::ToolTipRole:
+    case DescriptionRole:
+        return theme.description;
+    case AuthorRole:
+        return theme.authorName;
+    case AuthorEmailRole:
+        return theme.authorEmailAddress;
+    case VersionRole:
+        return theme.version;
+    case WebsiteRole:
+        return theme.website;
+    case CopyrightRole:
+        return theme.copyrightText;
+    case LicenseRole:
+        return theme.license;
+    default:
+        return {};
+    }
+}
+
+int KMahjonggThemeModel::rowForPath(const QString &path) const
+{
+    const auto it = std::find_if(m_themes.cbegin(), m_themes.cend(), [&path](const Theme &theme) {
+        return theme.path == path;
+    });
+    return (it != m_themes.cend()) ? static_cast<int>(it - m_themes.cbegin()) : -1;
+}
+
+void KMahjonggThemeModel::ensureMetadata(Theme &theme) const
+{
+    if (theme.metadataLoaded) {
+        return;
+    }
+    theme.metadataLoaded = true;
+
+    // the objects are only used to parse and check the .desktop file, their graphics are not loaded
+    if (m_kind == Tilesets) {
+        KMahjonggTileset tileset;
+        theme.valid = tileset.loadTileset(theme.path);
+        theme.name = tileset.name();
+        theme.description = tileset.description();
+        theme.authorName = tileset.authorName();
+        theme.authorEmailAddress = tileset.authorEmailAddress();
+        theme.version = tileset.version();
+        theme.website = tileset.website();
+        theme.copyrightText = tileset.copyrightText();
+        theme.license = tileset.license();
+    } else {
+        KMahjonggBackground background;
+        theme.valid = background.load(theme.path, m_backgroundSize.width(), m_backgroundSize.height());
+        theme.name = background.name();
+        theme.description = background.description();
+        theme.authorName = background.authorName();
+        theme.authorEmailAddress = background.authorEmailAddress();
+        theme.version = background.version();
+        theme.website = background.website();
+        theme.copyrightText = background.copyrightText();
+        theme.license = background.license();
+    }
+
+    // views do not expect rows to vanish while they query data
+    if (!theme.valid && !m_removalScheduled) {
+        m_removalScheduled = true;
+        auto *model = const_cast<KMahjonggThemeModel *>(this);
+        QTimer::singleShot(0, model, [model]() {
+            model->removeInvalidThemes();
+        });
+    }
+}
+
+KMahjonggTileset *KMahjonggThemeModel::tileset(int row)
+{
+    if (m_kind != Tilesets || row < 0 || row >= rowCount()) {
+        return nullptr;
+    }
+
+    Theme &theme = m_themes[row];
+    ensureMetadata(theme);
+    if (!theme.valid) {
+        return nullptr;
+    }
+    if (!theme.tileset) {
+        auto tileset = std::make_unique<KMahjonggTileset>();
+        if (!tileset->loadTileset(theme.path) || !tileset->loadGraphics()) {
+            return nullptr;
+        }
+        theme.tileset = std::move(tileset);
+    }
+
+    KMahjonggTileset *tileset = theme.tileset.get();
+    makeResident(theme.path);
+    return tileset;
+}
+
+KMahjonggBackground *KMahjonggThemeModel::background(int row)
+{
+    if (m_kind != Backgrounds || row < 0 || row >= rowCount()) {
+        return nullptr;
+    }
+
+    Theme &theme = m_themes[row];
+    ensureMetadata(theme);
+    if (!theme.valid) {
+        return nullptr;
+    }
+    if (!theme.background) {
+        auto background = std::make_unique<KMahjonggBackground>();
+        if (!background->load(theme.path, m_backgroundSize.width(), m_backgroundSize.height()) || !background->loadGraphics()) {
+            return nullptr;
+        }
+        theme.background = std::move(background);
+    }
+
+    KMahjonggBackground *background = theme.background.get();
+    makeResident(theme.path);
+    return background;
+}
+
+void KMahjonggThemeModel::setBackgroundSize(QSize size)
+{
+    m_backgroundSize = size;
+}
+
+void KMahjonggThemeModel::setMaximumResidentCount(int count)
+{
+    m_maximumResidentCount = std::max(1, count);
+    trimResidents();
+}
+
+int KMahjonggThemeModel::maximumResidentCount() const
+{
+    return m_maximumResidentCount;
+}
+
+void KMahjonggThemeModel::makeResident(const QString &path)
+{
+    m_residentPaths.removeOne(path);
+    m_residentPaths.prepend(path);
+    trimResidents();
+}
+
+void KMahjonggThemeModel::trimResidents()
+{
+    while (m_residentPaths.size() > m_maximumResidentCount) {
+        const int row = rowForPath(m_residentPaths.takeLast());
+        if (row >= 0) {
+            Theme &theme = m_themes[row];
+            theme.tileset.reset();
+            theme.background.reset();
+        }
+    }
+}
+
+void KMahjonggThemeModel::removeInvalidThemes()
+{
+    m_removalScheduled = false;
+
+    for (int row = rowCount() - 1; row >= 0; --row) {
+        if (m_themes[row].valid) {
+            continue;
+        }
+        beginRemoveRows(QModelIndex(), row, row);
+        m_residentPaths.removeOne(m_themes[row].path);
+        m_themes.erase(m_themes.begin() + row);
+        endRemoveRows();
+    }
+}
+
+#include "moc_kmahjonggthememodel_p.cpp"
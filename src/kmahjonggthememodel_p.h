@@ -0,0 +1,103 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef KMAHJONGGTHEMEMODEL_P_H
+#define KMAHJONGGTHEMEMODEL_P_H
+
+// Qt
+#include <QAbstractListModel>
+#include <QSize>
+#include <QStringList>
+// Std
+#include <memory>
+#include <vector>
+
+class KMahjonggTileset;
+class KMahjonggBackground;
+
+/**
+ * List of the installed tilesets or backgrounds, for the selectors.
+ *
+ * Only the .desktop files are located on construction. The metadata of a theme
+ * is read when a view first asks for its row, themes found invalid then are
+ * dropped from the model. Theme objects with graphics loaded are only kept for
+ * the most recently requested maximumResidentCount() themes.
+ */
+class KMahjonggThemeModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum Kind {
+        Tilesets,
+        Backgrounds,
+    };
+
+    enum Roles {
+        PathRole = Qt::UserRole + 1,
+        DescriptionRole,
+        AuthorRole,
+        AuthorEmailRole,
+        VersionRole,
+        WebsiteRole,
+        CopyrightRole,
+        LicenseRole,
+    };
+
+    explicit KMahjonggThemeModel(Kind kind, QObject *parent = nullptr);
+    ~KMahjonggThemeModel() override;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    /// @return the row of the theme with the .desktop file @p path, or -1
+    int rowForPath(const QString &path) const;
+
+    /**
+     * @return the tileset of @p row with graphics loaded, or nullptr if that failed.
+     * Owned by the model, valid until another theme object is requested.
+     */
+    KMahjonggTileset *tileset(int row);
+    /// see tileset(), loaded for the size set with setBackgroundSize()
+    KMahjonggBackground *background(int row);
+    void setBackgroundSize(QSize size);
+
+    void setMaximumResidentCount(int count);
+    int maximumResidentCount() const;
+
+private:
+    struct Theme {
+        QString path;
+        bool metadataLoaded = false;
+        bool valid = true;
+        QString name;
+        QString description;
+        QString authorName;
+        QString authorEmailAddress;
+        QString version;
+        QString website;
+        QString copyrightText;
+        QString license;
+        std::unique_ptr<KMahjonggTileset> tileset;
+        std::unique_ptr<KMahjonggBackground> background;
+    };
+
+    void ensureMetadata(Theme &theme) const;
+    void makeResident(const QString &path);
+    void trimResidents();
+    void removeInvalidThemes();
+
+private:
+    const Kind m_kind;
+    mutable std::vector<Theme> m_themes;
+    mutable bool m_removalScheduled = false;
+    // most recently used at the front
+    QStringList m_residentPaths;
+    int m_maximumResidentCount = 3;
+    QSize m_backgroundSize;
+};
+
+#endif // KMAHJONGGTHEMEMODEL_P_H
@@ -0,0 +1,150 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+// own
+#include "kmahjonggthemewatcher.h"
+
+// Qt
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QMultiHash>
+#include <QSet>
+#include <QTimer>
+// Std
+#include <utility>
+
+// LibKMahjongg
+#include "kmahjonggbackground.h"
+#include "kmahjonggtileset.h"
+
+class KMahjonggThemeWatcherPrivate
+{
+public:
+    void watchPath(const QString &path);
+    void unwatchPath(const QString &path);
+
+public:
+    QFileSystemWatcher watcher;
+    // editors write files in several steps, so changes are collected for a moment
+    QTimer reloadTimer;
+    QSet<QString> changedPaths;
+
+    QMultiHash<QString, KMahjonggTileset *> tilesets;
+    QMultiHash<QString, KMahjonggBackground *> backgrounds;
+};
+
+void KMahjonggThemeWatcherPrivate::watchPath(const QString &path)
+{
+    if (!path.isEmpty() && !watcher.files().contains(path)) {
+        watcher.addPath(path);
+    }
+}
+
+void KMahjonggThemeWatcherPrivate::unwatchPath(const QString &path)
+{
+    if (!tilesets.contains(path) && !backgrounds.contains(path)) {
+        watcher.removePath(path);
+    }
+}
+
+// ---------------------------------------------------------
+
+KMahjonggThemeWatcher::KMahjonggThemeWatcher(QObject *parent)
+    : QObject(parent)
+    , d_ptr(new KMahjonggThemeWatcherPrivate)
+{
+    Q_D(KMahjonggThemeWatcher);
+
+    d->reloadTimer.setSingleShot(true);
+    d->reloadTimer.setInterval(200);
+
+    connect(&d->watcher, &QFileSystemWatcher::fileChanged, this, [this](const QString &path) {
+        Q_D(KMahjonggThemeWatcher);
+
+        d->changedPaths.insert(path);
+        d->reloadTimer.start();
+    });
+
+    connect(&d->reloadTimer, &QTimer::timeout, this, [this]() {
+        Q_D(KMahjonggThemeWatcher);
+
+        const QSet<QString> changedPaths = std::exchange(d->changedPaths, {});
+        for (const QString &path : changedPaths) {
+            // saving by replacing the file ends the watching of the old one
+            if (QFileInfo::exists(path)) {
+                d->watchPath(path);
+            }
+
+            const QList<KMahjonggTileset *> tilesets = d->tilesets.values(path);
+            for (KMahjonggTileset *tileset : tilesets) {
+                const QStringList elementIds = tileset->reloadChangedElements();
+                if (!elementIds.isEmpty()) {
+                    Q_EMIT tilesetChanged(tileset, elementIds);
+                }
+            }
+            const QList<KMahjonggBackground *> backgrounds = d->backgrounds.values(path);
+            for (KMahjonggBackground *background : backgrounds) {
+                if (background->reloadIfChanged()) {
+                    Q_EMIT backgroundChanged(background);
+                }
+            }
+        }
+    });
+}
+
+KMahjonggThemeWatcher::~KMahjonggThemeWatcher() = default;
+
+void KMahjonggThemeWatcher::watchTileset(KMahjonggTileset *tileset)
+{
+    Q_D(KMahjonggThemeWatcher);
+
+    const QString path = tileset->graphicsSourcePath();
+    if (path.isEmpty() || d->tilesets.contains(path, tileset)) {
+        return;
+    }
+    tileset->startElementTracking();
+    d->tilesets.insert(path, tileset);
+    d->watchPath(path);
+}
+
+void KMahjonggThemeWatcher::unwatchTileset(KMahjonggTileset *tileset)
+{
+    Q_D(KMahjonggThemeWatcher);
+
+    const QString path = d->tilesets.key(tileset);
+    if (path.isEmpty()) {
+        return;
+    }
+    d->tilesets.remove(path, tileset);
+    d->unwatchPath(path);
+}
+
+void KMahjonggThemeWatcher::watchBackground(KMahjonggBackground *background)
+{
+    Q_D(KMahjonggThemeWatcher);
+
+    const QString path = background->graphicsSourcePath();
+    if (path.isEmpty() || d->backgrounds.contains(path, background)) {
+        return;
+    }
+    background->startChangeTracking();
+    d->backgrounds.insert(path, background);
+    d->watchPath(path);
+}
+
+void KMahjonggThemeWatcher::unwatchBackground(KMahjonggBackground *background)
+{
+    Q_D(KMahjonggThemeWatcher);
+
+    const QString path = d->backgrounds.key(background);
+    if (path.isEmpty()) {
+        return;
+    }
+    d->backgrounds.remove(path, background);
+    d->unwatchPath(path);
+}
+
+#include "moc_kmahjonggthemewatcher.cpp"
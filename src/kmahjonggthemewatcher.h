@@ -0,0 +1,63 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef KMAHJONGGTHEMEWATCHER_H
+#define KMAHJONGGTHEMEWATCHER_H
+
+// Qt
+#include <QObject>
+#include <QStringList>
+// Std
+#include <memory>
+
+// LibKMahjongg
+#include <libkmahjongg_export.h>
+
+class KMahjonggTileset;
+class KMahjonggBackground;
+class KMahjonggThemeWatcherPrivate;
+
+/**
+ * @class KMahjonggThemeWatcher kmahjonggthemewatcher.h <KMahjonggThemeWatcher>
+ *
+ * Reloads tilesets and backgrounds when their graphics files change on disk,
+ * e.g. while a theme is edited.
+ *
+ * For tilesets only the elements whose SVG subtree changed are evicted from the caches.
+ * This needs the file to be uncompressed, with compressed files all elements count as changed.
+ *
+ * Watched tilesets and backgrounds need to be unwatched before they are deleted.
+ */
+class LIBKMAHJONGG_EXPORT KMahjonggThemeWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit KMahjonggThemeWatcher(QObject *parent = nullptr);
+    ~KMahjonggThemeWatcher() override;
+
+    /// @p tileset needs to have its graphics loaded
+    void watchTileset(KMahjonggTileset *tileset);
+    void unwatchTileset(KMahjonggTileset *tileset);
+    /// @p background needs to have its graphics loaded
+    void watchBackground(KMahjonggBackground *background);
+    void unwatchBackground(KMahjonggBackground *background);
+
+Q_SIGNALS:
+    /**
+     * Emitted after @p tileset got reloaded.
+     * @param elementIds the ids of the elements whose rendering changed, like "TILE_1" or "BAMBOO_3"
+     */
+    void tilesetChanged(KMahjonggTileset *tileset, const QStringList &elementIds);
+    void backgroundChanged(KMahjonggBackground *background);
+
+private:
+    std::unique_ptr<KMahjonggThemeWatcherPrivate> const d_ptr;
+    Q_DECLARE_PRIVATE(KMahjonggThemeWatcher)
+    Q_DISABLE_COPY(KMahjonggThemeWatcher)
+};
+
+#endif // KMAHJONGGTHEMEWATCHER_H
@@ -0,0 +1,129 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef KMAHJONGGTILEELEMENTS_P_H
+#define KMAHJONGGTILEELEMENTS_P_H
+
+// Qt
+#include <QList>
+#include <QString>
+#include <QStringView>
+// Std
+#include <array>
+
+/**
+ * The ids of the tileset elements, in the order of the tile enums of KMahjonggTileset.
+ * Unselected tile bodies first, then the selected ones, then the faces.
+ */
+namespace KMahjonggTileElements
+{
+
+constexpr int BodyCount = 4;
+constexpr int SelectedOffset = BodyCount;
+constexpr int FaceOffset = 2 * BodyCount;
+constexpr int FaceCount = 42;
+constexpr int Count = FaceOffset + FaceCount;
+
+constexpr std::array<QStringView, Count> ids = {
+    u"TILE_1",
+    u"TILE_2",
+    u"TILE_3",
+    u"TILE_4",
+    u"TILE_1_SEL",
+    u"TILE_2_SEL",
+    u"TILE_3_SEL",
+    u"TILE_4_SEL",
+    u"CHARACTER_1",
+    u"CHARACTER_2",
+    u"CHARACTER_3",
+    u"CHARACTER_4",
+    u"CHARACTER_5",
+    u"CHARACTER_6",
+    u"CHARACTER_7",
+    u"CHARACTER_8",
+    u"CHARACTER_9",
+    u"BAMBOO_1",
+    u"BAMBOO_2",
+    u"BAMBOO_3",
+    u"BAMBOO_4",
+    u"BAMBOO_5",
+    u"BAMBOO_6",
+    u"BAMBOO_7",
+    u"BAMBOO_8",
+    u"BAMBOO_9",
+    u"ROD_1",
+    u"ROD_2",
+    u"ROD_3",
+    u"ROD_4",
+    u"ROD_5",
+    u"ROD_6",
+    u"ROD_7",
+    u"ROD_8",
+    u"ROD_9",
+    u"SEASON_1",
+    u"SEASON_2",
+    u"SEASON_3",
+    u"SEASON_4",
+    u"WIND_1",
+    u"WIND_2",
+    u"WIND_3",
+    u"WIND_4",
+    u"DRAGON_1",
+    u"DRAGON_2",
+    u"DRAGON_3",
+    u"FLOWER_1",
+    u"FLOWER_2",
+    u"FLOWER_3",
+    u"FLOWER_4",
+};
+
+constexpr bool isValidBody(int body)
+{
+    return body >= 0 && body < BodyCount;
+}
+
+constexpr bool isValidFace(int face)
+{
+    return face >= 0 && face < FaceCount;
+}
+
+constexpr int selectedIndex(int body)
+{
+    return SelectedOffset + body;
+}
+
+constexpr int faceIndex(int face)
+{
+    return FaceOffset + face;
+}
+
+constexpr bool isFace(int index)
+{
+    return index >= FaceOffset;
+}
+
+constexpr bool isSelected(int index)
+{
+    return index >= SelectedOffset && index < FaceOffset;
+}
+
+/// ids as QStrings referencing the static data, created once
+inline const QList<QString> &idList()
+{
+    static const QList<QString> list = []() {
+        QList<QString> result;
+        result.reserve(Count);
+        for (QStringView id : ids) {
+            result.append(QString::fromRawData(id.data(), id.size()));
+        }
+        return result;
+    }();
+    return list;
+}
+
+}
+
+#endif // KMAHJONGGTILEELEMENTS_P_H
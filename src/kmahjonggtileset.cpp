@@ -9,15 +9,24 @@
 #include "kmahjonggtileset.h"
 
 // STL
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>
+#include <functional>
 
 // Qt
 #include <QFile>
-#include <QGuiApplication>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QPainter>
-#include <QPixmapCache>
+#include <QRectF>
+#include <QScopedValueRollback>
 #include <QStandardPaths>
-#include <QSvgRenderer>
+#include <QTransform>
 
 // KF
 #include <KConfig>
@@ -25,8 +34,30 @@
 #include <KLocalizedString>
 
 // LibKMahjongg
+#include "kmahjonggboardgeometry_p.h"
+#include "kmahjonggcache_p.h"
+#include "kmahjonggelementhash_p.h"
+#include "kmahjonggimagekernels_p.h"
+#include "kmahjonggsnapshotcache_p.h"
+#include "kmahjonggspritesheets_p.h"
+#include "kmahjonggsvgrendererpool_p.h"
+#include "kmahjonggtileelements_p.h"
+#include "kmahjonggutils_p.h"
 #include "libkmahjongg_debug.h"
 
+// size of the renderings all smaller element sizes are derived from, relative to the .desktop metrics
+constexpr int kMasterScale = 2;
+
+// device pixel ratios the image cache keeps renderings for, e.g. of the widgets and of a QML scene
+constexpr int kImageCacheScaleCount = 2;
+
+namespace
+{
+// set while the current thread renders ahead of time for KMahjonggPrerenderer or KMahjonggTilesetLoader,
+// so not for an actual paint request
+thread_local bool renderingAhead = false;
+}
+
 class KMahjonggTilesetMetricsData
 {
 public:
@@ -46,12 +77,57 @@ public:
     KMahjonggTilesetPrivate() = default;
 
     void updateScaleInfo(short tilew, short tileh);
-    void buildElementIdTable();
-    QString pixmapCacheNameFromElementId(const QString &elementid, short width, short height) const;
-    QPixmap renderElement(short width, short height, const QString &elementid) const;
+    bool loadElementIndex();
+    QHash<QString, QByteArray> computeElementHashes(QByteArray *sharedHash = nullptr) const;
+    void evictElement(int index);
+    QList<QString> spriteCacheKeys(const QHash<QString, QByteArray> &hashes) const;
+    QString pixmapCacheNameFromElementId(const QString &elementKey, short width, short height) const;
+    QString elementCacheName(int index, short width, short height) const;
+    QString compositeCacheName(int num, int face, bool selected, short width, short height) const;
+    bool isTintedSelection(int index) const;
+    QImage tintedSelection(QImage body) const;
+    bool loadGraphicsData();
+    QSize masterSize(int index) const;
+    QList<QImage> mipChain(int index) const;
+    QImage renderElement(short width, short height, int index) const;
+    QImage cachedImage(const QString &cacheName, KMahjonggTileset::Rotation rotation, const std::function<QImage()> &create) const;
+    void useImageScale(qreal dpr) const;
+    void clearImageCache();
+    QPixmap cachedPixmap(KMahjonggCache::Partition partition,
+                         const QString &cacheName,
+                         KMahjonggTileset::Rotation rotation,
+                         qreal dpr,
+                         const std::function<QPixmap()> &create) const;
+    QImage elementImage(int index, short width, short height, qreal dpr, KMahjonggTileset::Rotation rotation = KMahjonggTileset::Rotate0) const;
+    QPixmap elementPixmap(KMahjonggCache::Partition partition,
+                          int index,
+                          short width,
+                          short height,
+                          qreal dpr,
+                          KMahjonggTileset::Rotation rotation = KMahjonggTileset::Rotate0) const;
+    int elementPixmaps(KMahjonggCache::Partition partition,
+                       int firstIndex,
+                       int available,
+                       std::span<QPixmap> pixmaps,
+                       short logicalWidth,
+                       short logicalHeight,
+                       KMahjonggTileset::Rotation rotation) const;
+    QImage compositeImage(int num, int face, bool selected, qreal dpr, KMahjonggTileset::Rotation rotation) const;
+    QPixmap compositePixmap(int num, int face, bool selected, qreal dpr, KMahjonggTileset::Rotation rotation) const;
+    QPoint faceOffset(int num) const;
 
 public:
-    QList<QString> elementIdTable;
+    // shares the data of the static table
+    const QList<QString> elementIdTable = KMahjonggTileElements::idList();
+    // identify the content of the elements in the caches, matching elementIdTable
+    QList<QString> elementCacheKeys;
+    // subtree hashes of the loaded file, only while watched by KMahjonggThemeWatcher
+    QHash<QString, QByteArray> elementHashes;
+    // of the content outside the elements, like gradients in the defs, which any element might use
+    QByteArray sharedContentHash;
+    // as when tracking started, the cache keys of the elements were made for that
+    QByteArray trackedSharedContentHash;
+    int reloadCount = 0;
 
     QString name;
     QString description;
@@ -63,12 +139,27 @@ public:
     QString authorName;
     QString authorEmailAddress;
 
+    // if valid, selected tiles are derived from the unselected ones instead of rendering TILE_n_SEL
+    QColor selectionTint;
+    qreal selectionTintStrength = 0.5;
+
     KMahjonggTilesetMetricsData originaldata;
     KMahjonggTilesetMetricsData scaleddata;
     QString filename; // cache the last file loaded to save reloading it
     QString graphicspath;
 
-    mutable QSvgRenderer svg; // render() is non-const
+    KMahjonggSvgRendererPool svg;
+    // used instead of svg for raster tilesets
+    KMahjonggSpriteSheets sprites;
+    // images rendered by the thread-safe API, for the scales in imageCacheScales
+    mutable KMahjonggSnapshotCache<QImage> imageCache;
+    // least recently used first, guarded by imageCacheScalesMutex
+    mutable QList<qreal> imageCacheScales;
+    mutable QMutex imageCacheScalesMutex;
+    // the last one of imageCacheScales, so the usual single scale needs no locking
+    mutable std::atomic<qreal> lastImageCacheScale = 0;
+    // per element cache key, renderings at masterSize() and their halvings
+    mutable KMahjonggSnapshotCache<QList<QImage>> mipChains;
     bool isSVG = false;
     bool graphicsLoaded = false;
 };
@@ -80,13 +171,17 @@ KMahjonggTileset::KMahjonggTileset()
 {
     Q_D(KMahjonggTileset);
 
-    d->buildElementIdTable();
+    d->elementCacheKeys = d->elementIdTable;
 }
 
 // ---------------------------------------------------------
 
+KMahjonggTileset::KMahjonggTileset(KMahjonggTileset &&other) noexcept = default;
+
 KMahjonggTileset::~KMahjonggTileset() = default;
 
+KMahjonggTileset &KMahjonggTileset::operator=(KMahjonggTileset &&other) noexcept = default;
+
 void KMahjonggTilesetPrivate::updateScaleInfo(short tilew, short tileh)
 {
     scaleddata.w = tilew;
@@ -241,6 +336,13 @@ short KMahjonggTileset::qHeight() const
     return static_cast<short>(d->scaleddata.fh / 2.0);
 }
 
+QSize KMahjonggTileset::faceSize() const
+{
+    Q_D(const KMahjonggTileset);
+
+    return QSize(d->scaleddata.fw, d->scaleddata.fh);
+}
+
 QString KMahjonggTileset::path() const
 {
     Q_D(const KMahjonggTileset);
@@ -248,7 +350,45 @@ QString KMahjonggTileset::path() const
     return d->filename;
 }
 
-#define kTilesetVersionFormat 1
+bool KMahjonggTileset::tilePositions(std::span<const int> x,
+                                     std::span<const int> y,
+                                     std::span<const int> level,
+                                     std::span<int> left,
+                                     std::span<int> top,
+                                     int variant,
+                                     int levels) const
+{
+    Q_D(const KMahjonggTileset);
+
+    const std::size_t count = x.size();
+    if (y.size() != count || level.size() != count || left.size() != count || top.size() != count) {
+        return false;
+    }
+
+    // same layout as KMahjonggBoardGeometry::tileRect(), but with all factors hoisted,
+    // so the loops are plain multiply-adds the compiler can vectorise
+    const bool sidesLeft = (variant == 0 || variant == 3);
+    const bool sidesTop = (variant == 2 || variant == 3);
+    const int qw = qWidth();
+    const int qh = qHeight();
+    const int stepX = sidesLeft ? d->scaleddata.lvloffx : -d->scaleddata.lvloffx;
+    const int stepY = sidesTop ? d->scaleddata.lvloffy : -d->scaleddata.lvloffy;
+    const int originX = sidesLeft ? 0 : (levels - 1) * d->scaleddata.lvloffx;
+    const int originY = sidesTop ? 0 : (levels - 1) * d->scaleddata.lvloffy;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        left[i] = x[i] * qw + level[i] * stepX + originX;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        top[i] = y[i] * qh + level[i] * stepY + originY;
+    }
+    return true;
+}
+
+static_assert(KMahjonggTileset::BodyCount == KMahjonggTileElements::BodyCount);
+static_assert(KMahjonggTileset::FaceCount == KMahjonggTileElements::FaceCount);
+
+#define kTilesetVersionFormat 2
 
 // ---------------------------------------------------------
 bool KMahjonggTileset::loadTileset(const QString &tilesetPath)
@@ -298,11 +438,24 @@ bool KMahjonggTileset::loadTileset(const QString &tilesetPath)
     d->graphicspath = QStandardPaths::locate(QStandardPaths::GenericDataLocation, QStringLiteral("kmahjongglib/tilesets/") + graphName);
     // qCDebug(LIBKMAHJONGG_LOG) << "Using tileset at" << d->graphicspath;
 
-    // only SVG for now
-    d->isSVG = true;
+    // since format 2 FileName can also point to the index of pre-rasterised sprite sheets
+    d->isSVG = (tileversion < 2 || group.readEntry("GraphicsType", QStringLiteral("SVG")).compare(QLatin1String("Raster"), Qt::CaseInsensitive) != 0);
     if (d->graphicspath.isEmpty()) {
         return false;
     }
+    if (d->isSVG) {
+        d->sprites.clear();
+        if (!d->loadElementIndex()) {
+            return false;
+        }
+    } else {
+        // the sprite index has all the element data, the sheets themselves are read on first use
+        d->svg.clear();
+        if (!d->sprites.load(d->graphicspath, d->elementIdTable)) {
+            return false;
+        }
+        d->elementCacheKeys = d->spriteCacheKeys(d->sprites.elementHashes());
+    }
 
     d->originaldata.w = group.readEntry("TileWidth", 30);
     d->originaldata.h = group.readEntry("TileHeight", 50);
@@ -311,6 +464,10 @@ bool KMahjonggTileset::loadTileset(const QString &tilesetPath)
     d->originaldata.lvloffx = group.readEntry("LevelOffsetX", 10);
     d->originaldata.lvloffy = group.readEntry("LevelOffsetY", 10);
 
+    d->selectionTint = group.readEntry("SelectionTint", QColor());
+    // percent, bounded like by setSelectionTint()
+    d->selectionTintStrength = qBound(0.0, group.readEntry("SelectionTintStrength", 50) / 100.0, 1.0);
+
     // client application needs to call loadGraphics()
     d->graphicsLoaded = false;
     d->filename = tilesetPath;
@@ -326,22 +483,54 @@ bool KMahjonggTileset::loadGraphics()
     if (d->graphicsLoaded) {
         return true;
     }
-    if (d->isSVG) {
+    if (!d->loadGraphicsData()) {
+        return false;
+    }
+    // invalidate our tile caches
+    KMahjonggCache::clear(KMahjonggCache::TileBodies);
+    KMahjonggCache::clear(KMahjonggCache::TileFaces);
+    reloadTileset(QSize(d->originaldata.w, d->originaldata.h));
+
+    return true;
+}
+
+bool KMahjonggTilesetPrivate::loadGraphicsData()
+{
+    if (isSVG) {
         // really?
-        d->svg.load(d->graphicspath);
-        if (d->svg.isValid()) {
-            // invalidate our global cache
-            QPixmapCache::clear();
-            d->graphicsLoaded = true;
-            reloadTileset(QSize(d->originaldata.w, d->originaldata.h));
-        } else {
+        if (!svg.load(graphicspath)) {
             return false;
         }
     } else {
-        // TODO add support for png??
-        return false;
+        // the sprite index was read by loadTileset() already, nothing to parse
+        if (!sprites.isValid()) {
+            return false;
+        }
     }
+    clearImageCache();
+    mipChains.clear();
+    graphicsLoaded = true;
+    return true;
+}
 
+bool KMahjonggTileset::prepareGraphics(QSize tileSize, qreal devicePixelRatio)
+{
+    Q_D(KMahjonggTileset);
+
+    // the pixmap caches are left alone, they may only be touched on the GUI thread
+    if (!d->graphicsLoaded && !d->loadGraphicsData()) {
+        return false;
+    }
+    reloadTileset(tileSize.isEmpty() ? QSize(d->originaldata.w, d->originaldata.h) : tileSize);
+
+    // the pixmap getters pick these up, leaving only the conversion to pixmaps to the GUI thread
+    const QScopedValueRollback<bool> rollback(renderingAhead, true);
+    for (int index = 0; index < d->elementIdTable.size(); ++index) {
+        const bool isFace = KMahjonggTileElements::isFace(index);
+        const short width = (isFace ? d->scaleddata.fw : d->scaleddata.w) * devicePixelRatio;
+        const short height = (isFace ? d->scaleddata.fh : d->scaleddata.h) * devicePixelRatio;
+        d->elementImage(index, width, height, devicePixelRatio);
+    }
     return true;
 }
 
@@ -357,73 +546,153 @@ bool KMahjonggTileset::reloadTileset(QSize newTilesize)
     if (d->isSVG) {
         if (d->svg.isValid()) {
             d->updateScaleInfo(newTilesize.width(), newTilesize.height());
-            // rendering will be done when needed, automatically using the global cache
+            // images of other sizes are rarely reused, the pixmap caches take care of that
+            d->clearImageCache();
+            // rendering will be done when needed, automatically using the tile caches
         } else {
             return false;
         }
     } else {
-        // TODO add support for png???
-        return false;
+        if (d->sprites.isValid()) {
+            d->updateScaleInfo(newTilesize.width(), newTilesize.height());
+            d->clearImageCache();
+        } else {
+            return false;
+        }
     }
 
     return true;
 }
 
-void KMahjonggTilesetPrivate::buildElementIdTable()
+bool KMahjonggTilesetPrivate::loadElementIndex()
 {
-    constexpr int tileCount = 4;
-    constexpr int characterCount = 9;
-    constexpr int bambooCount = 9;
-    constexpr int rodCount = 9;
-    constexpr int seasonCount = 4;
-    constexpr int windCount = 4;
-    constexpr int dragonCount = 3;
-    constexpr int flowerCount = 4;
-
-    elementIdTable.reserve(2 * tileCount + characterCount + bambooCount + rodCount + seasonCount + windCount + dragonCount + flowerCount);
-
-    // Build a list for faster lookup of element ids, mapped to the enumeration used by GameData and BoardWidget
-    // Unselected tiles
-    for (short idx = 1; idx <= tileCount; idx++) {
-        elementIdTable.append(QStringLiteral("TILE_%1").arg(idx));
-    }
-    // Selected tiles
-    for (short idx = 1; idx <= tileCount; idx++) {
-        elementIdTable.append(QStringLiteral("TILE_%1_SEL").arg(idx));
-    }
-    // now faces
-    for (short idx = 1; idx <= characterCount; idx++) {
-        elementIdTable.append(QStringLiteral("CHARACTER_%1").arg(idx));
+    elementCacheKeys.clear();
+    elementCacheKeys.reserve(elementIdTable.size());
+
+    // generated when building the tileset, named after the SVG file
+    const QFileInfo graphicsFileInfo(graphicspath);
+    QFile indexFile(graphicsFileInfo.absolutePath() + QLatin1Char('/') + graphicsFileInfo.completeBaseName() + QLatin1String(".elements.json"));
+    const QJsonObject index = indexFile.open(QIODevice::ReadOnly) ? QJsonDocument::fromJson(indexFile.readAll()).object() : QJsonObject();
+    if (index.isEmpty() || index.value(QLatin1String("version")).toInt() != 1) {
+        // third-party tilesets, only find out about missing elements on rendering
+        for (const QString &elementId : std::as_const(elementIdTable)) {
+            elementCacheKeys.append(name + elementId);
+        }
+        return true;
     }
-    for (short idx = 1; idx <= bambooCount; idx++) {
-        elementIdTable.append(QStringLiteral("BAMBOO_%1").arg(idx));
+
+    const QJsonObject elements = index.value(QLatin1String("elements")).toObject();
+    const QString fileName = graphicsFileInfo.fileName();
+    for (const QString &elementId : std::as_const(elementIdTable)) {
+        const QJsonObject element = elements.value(elementId).toObject();
+        if (element.isEmpty()) {
+            qCWarning(LIBKMAHJONGG_LOG) << "Tileset" << graphicspath << "misses element" << elementId;
+            return false;
+        }
+        // changes with the content, so updated files never hit old entries
+        const QString hash = element.value(QLatin1String("hash")).toString();
+        elementCacheKeys.append(fileName + (hash.isEmpty() ? elementId : hash));
     }
-    for (short idx = 1; idx <= rodCount; idx++) {
-        elementIdTable.append(QStringLiteral("ROD_%1").arg(idx));
+    return true;
+}
+
+QList<QString> KMahjonggTilesetPrivate::spriteCacheKeys(const QHash<QString, QByteArray> &hashes) const
+{
+    // the hashes are those of the source SVG, so keep raster and SVG renderings apart
+    const QString prefix = QFileInfo(graphicspath).fileName();
+    QList<QString> keys;
+    keys.reserve(elementIdTable.size());
+    for (const QString &elementId : elementIdTable) {
+        const QByteArray hash = hashes.value(elementId);
+        keys.append(prefix + (hash.isEmpty() ? elementId : QString::fromLatin1(hash)));
     }
-    for (short idx = 1; idx <= seasonCount; idx++) {
-        elementIdTable.append(QStringLiteral("SEASON_%1").arg(idx));
+    return keys;
+}
+
+QString KMahjonggTilesetPrivate::pixmapCacheNameFromElementId(const QString &elementKey, short width, short height) const
+{
+    return elementKey + QStringLiteral("W%1H%2").arg(width).arg(height);
+}
+
+QString KMahjonggTilesetPrivate::elementCacheName(int index, short width, short height) const
+{
+    if (isTintedSelection(index)) {
+        // derived from the unselected body, keep the tint in the name, so changing it at runtime does not hit stale entries
+        const QString tintKey = elementCacheKeys.at(index - KMahjonggTileElements::SelectedOffset) + selectionTint.name(QColor::HexRgb) + QString::number(selectionTintStrength);
+        return pixmapCacheNameFromElementId(tintKey, width, height);
     }
-    for (short idx = 1; idx <= windCount; idx++) {
-        elementIdTable.append(QStringLiteral("WIND_%1").arg(idx));
+    return pixmapCacheNameFromElementId(elementCacheKeys.at(index), width, height);
+}
+
+bool KMahjonggTilesetPrivate::isTintedSelection(int index) const
+{
+    return selectionTint.isValid() && KMahjonggTileElements::isSelected(index);
+}
+
+QImage KMahjonggTilesetPrivate::tintedSelection(QImage body) const
+{
+    KMahjonggImageKernels::tint(body, selectionTint, selectionTintStrength);
+    return body;
+}
+
+QSize KMahjonggTilesetPrivate::masterSize(int index) const
+{
+    const bool isFace = KMahjonggTileElements::isFace(index);
+    const short width = isFace ? originaldata.fw : originaldata.w;
+    const short height = isFace ? originaldata.fh : originaldata.h;
+    return QSize(width, height) * kMasterScale;
+}
+
+QList<QImage> KMahjonggTilesetPrivate::mipChain(int index) const
+{
+    const QString &key = elementCacheKeys.at(index);
+    QList<QImage> cachedChain;
+    if (mipChains.find(key, &cachedChain)) {
+        return cachedChain;
     }
-    for (short idx = 1; idx <= dragonCount; idx++) {
-        elementIdTable.append(QStringLiteral("DRAGON_%1").arg(idx));
+
+    // the SVG is rendered once per element, all smaller sizes are derived from that
+    QList<QImage> chain;
+    const QSize size = masterSize(index);
+    QImage master(size, QImage::Format_ARGB32_Premultiplied);
+    master.fill(Qt::transparent);
+    if (svg.isValid()) {
+        QPainter p(&master);
+        svg.render(&p, elementIdTable.at(index));
     }
-    for (short idx = 1; idx <= flowerCount; idx++) {
-        elementIdTable.append(QStringLiteral("FLOWER_%1").arg(idx));
+    chain.append(master);
+    while (chain.last().width() >= 16 && chain.last().height() >= 16) {
+        chain.append(KMahjonggImageKernels::halved(chain.last()));
     }
-}
 
-QString KMahjonggTilesetPrivate::pixmapCacheNameFromElementId(const QString &elementid, short width, short height) const
-{
-    return name + elementid + QStringLiteral("W%1H%2").arg(width).arg(height);
+    mipChains.insert(key, chain);
+    return chain;
 }
 
-QPixmap KMahjonggTilesetPrivate::renderElement(short width, short height, const QString &elementid) const
+QImage KMahjonggTilesetPrivate::renderElement(short width, short height, int index) const
 {
+    const QString &elementid = elementIdTable.at(index);
     // qCDebug(LIBKMAHJONGG_LOG) << "render element" << elementid << width << height;
-    QPixmap qiRend(width, height);
+    if (!isSVG) {
+        QImage sprite = sprites.render(elementid, QSize(width, height));
+        if (!sprite.isNull()) {
+            return sprite;
+        }
+    }
+
+    const QSize size(width, height);
+    if (isSVG && !size.isEmpty() && size.boundedTo(masterSize(index)) == size) {
+        // start from the smallest level still at least as large
+        const QList<QImage> chain = mipChain(index);
+        auto level = chain.crbegin();
+        while (level->width() < width || level->height() < height) {
+            ++level;
+        }
+        return KMahjonggImageKernels::downsampled(*level, size);
+    }
+
+    // larger than the master, which would only be scaled up
+    QImage qiRend(width, height, QImage::Format_ARGB32_Premultiplied);
     qiRend.fill(Qt::transparent);
 
     if (svg.isValid()) {
@@ -433,69 +702,569 @@ QPixmap KMahjonggTilesetPrivate::renderElement(short width, short height, const
     return qiRend;
 }
 
-QPixmap KMahjonggTileset::selectedTile(int num) const
+namespace
 {
-    Q_D(const KMahjonggTileset);
+QString rotationSuffix(KMahjonggTileset::Rotation rotation)
+{
+    return rotation == KMahjonggTileset::Rotate0 ? QString() : QStringLiteral("R%1").arg(static_cast<int>(rotation));
+}
+
+QTransform rotationTransform(KMahjonggTileset::Rotation rotation)
+{
+    // multiples of 90 degrees are plain pixel moves, without any resampling
+    return QTransform().rotate(static_cast<int>(rotation));
+}
+}
+
+QImage KMahjonggTilesetPrivate::cachedImage(const QString &cacheName, KMahjonggTileset::Rotation rotation, const std::function<QImage()> &create) const
+{
+    const QString imageCacheName = cacheName + rotationSuffix(rotation);
+    QImage image;
+    if (imageCache.find(imageCacheName, &image)) {
+        return image;
+    }
+
+    if (rotation == KMahjonggTileset::Rotate0) {
+        image = create();
+    } else {
+        // rotated once from the upright image, which is cached as well
+        const QImage upright = cachedImage(cacheName, KMahjonggTileset::Rotate0, create);
+        image = upright.transformed(rotationTransform(rotation));
+        image.setDevicePixelRatio(upright.devicePixelRatio());
+    }
+
+    imageCache.insert(imageCacheName, image);
+    return image;
+}
+
+void KMahjonggTilesetPrivate::useImageScale(qreal dpr) const
+{
+    if (lastImageCacheScale.load(std::memory_order_relaxed) == dpr) {
+        return;
+    }
+
+    const QMutexLocker locker(&imageCacheScalesMutex);
+    imageCacheScales.removeOne(dpr);
+    imageCacheScales.append(dpr);
+    lastImageCacheScale.store(dpr, std::memory_order_relaxed);
+    if (imageCacheScales.size() <= kImageCacheScaleCount) {
+        return;
+    }
+
+    // e.g. a QML scene asking for every size while its window is resized, so drop the oldest scale
+    const qreal evictedScale = imageCacheScales.takeFirst();
+    const QString tileSizeKey = pixmapCacheNameFromElementId(QString(), scaleddata.w * evictedScale, scaleddata.h * evictedScale);
+    const QString faceSizeKey = pixmapCacheNameFromElementId(QString(), scaleddata.fw * evictedScale, scaleddata.fh * evictedScale);
+    imageCache.removeIf([&tileSizeKey, &faceSizeKey](const QString &imageKey) {
+        return imageKey.contains(tileSizeKey) || imageKey.contains(faceSizeKey);
+    });
+}
+
+void KMahjonggTilesetPrivate::clearImageCache()
+{
+    const QMutexLocker locker(&imageCacheScalesMutex);
+
+    imageCache.clear();
+    imageCacheScales.clear();
+    lastImageCacheScale.store(0, std::memory_order_relaxed);
+}
 
+QPixmap KMahjonggTilesetPrivate::cachedPixmap(KMahjonggCache::Partition partition,
+                                              const QString &cacheName,
+                                              KMahjonggTileset::Rotation rotation,
+                                              qreal dpr,
+                                              const std::function<QPixmap()> &create) const
+{
     QPixmap pm;
 
-    const qreal dpr = qApp->devicePixelRatio();
-    // use tile size
-    const short width = d->scaleddata.w * dpr;
-    const short height = d->scaleddata.h * dpr;
-    QString elemId = d->elementIdTable.at(num + 4); // selected offset in our idtable;
-    // using raw pixmap size with cache id, as the rendering is done dpr-ignorant
-    const  QString pixmapCacheName = d->pixmapCacheNameFromElementId(elemId, width, height);
-    if (!QPixmapCache::find(pixmapCacheName, &pm)) {
-        pm = d->renderElement(width, height, elemId);
+    const QString pixmapCacheName = cacheName + rotationSuffix(rotation);
+    KMahjonggCachePrivate *cache = KMahjonggCachePrivate::instance();
+    if (!cache->find(partition, pixmapCacheName, &pm)) {
+        if (rotation == KMahjonggTileset::Rotate0) {
+            pm = create();
+        } else {
+            pm = cachedPixmap(partition, cacheName, KMahjonggTileset::Rotate0, dpr, create).transformed(rotationTransform(rotation));
+        }
         pm.setDevicePixelRatio(dpr);
-        QPixmapCache::insert(pixmapCacheName, pm);
+        cache->insert(partition, pixmapCacheName, pm);
     }
     return pm;
 }
 
-QPixmap KMahjonggTileset::unselectedTile(int num) const
+QImage KMahjonggTilesetPrivate::elementImage(int index, short width, short height, qreal dpr, KMahjonggTileset::Rotation rotation) const
+{
+    useImageScale(dpr);
+    // using raw image size with cache id, as the rendering is done dpr-ignorant
+    return cachedImage(elementCacheName(index, width, height), rotation, [this, index, width, height, dpr]() {
+        // e.g. for KMahjonggBoardCompositor or QML, which paint with the result
+        if (!renderingAhead) {
+            KMahjonggCachePrivate::instance()->noteDemandRender();
+        }
+        QImage image = isTintedSelection(index) ? tintedSelection(elementImage(index - KMahjonggTileElements::SelectedOffset, width, height, dpr)) //
+                                                : renderElement(width, height, index);
+        image.setDevicePixelRatio(dpr);
+        return image;
+    });
+}
+
+QPixmap KMahjonggTilesetPrivate::elementPixmap(KMahjonggCache::Partition partition,
+                                               int index,
+                                               short width,
+                                               short height,
+                                               qreal dpr,
+                                               KMahjonggTileset::Rotation rotation) const
+{
+    // using raw pixmap size with cache id, as the rendering is done dpr-ignorant
+    const QString pixmapCacheName = elementCacheName(index, width, height);
+    return cachedPixmap(partition, pixmapCacheName, rotation, dpr, [this, partition, index, width, height, dpr, pixmapCacheName]() {
+        // reuse what a worker thread might have already rendered
+        QImage image = imageCache.value(pixmapCacheName);
+        if (image.isNull()) {
+            if (!renderingAhead) {
+                KMahjonggCachePrivate::instance()->noteDemandRender();
+            }
+            image = isTintedSelection(index) ? tintedSelection(elementPixmap(partition, index - KMahjonggTileElements::SelectedOffset, width, height, dpr).toImage()) //
+                                             : renderElement(width, height, index);
+        }
+        // conversion to pixmap happens only here, at the edge to the GUI thread
+        return QPixmap::fromImage(std::move(image));
+    });
+}
+
+QString KMahjonggTilesetPrivate::compositeCacheName(int num, int face, bool selected, short width, short height) const
+{
+    return elementCacheName(selected ? KMahjonggTileElements::selectedIndex(num) : num, width, height) + elementCacheKeys.at(KMahjonggTileElements::faceIndex(face));
+}
+
+QPoint KMahjonggTilesetPrivate::faceOffset(int num) const
+{
+    // composed the same way as by KMahjonggBoardCompositor
+    KMahjonggBoardGeometry geometry;
+    geometry.variant = num;
+    geometry.metrics.w = scaleddata.w;
+    geometry.metrics.h = scaleddata.h;
+    return geometry.faceOffset(QSize(scaleddata.fw, scaleddata.fh));
+}
+
+QImage KMahjonggTilesetPrivate::compositeImage(int num, int face, bool selected, qreal dpr, KMahjonggTileset::Rotation rotation) const
+{
+    useImageScale(dpr);
+    const short width = scaleddata.w * dpr;
+    const short height = scaleddata.h * dpr;
+    return cachedImage(compositeCacheName(num, face, selected, width, height), rotation, [this, num, face, selected, width, height, dpr]() {
+        QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
+        image.setDevicePixelRatio(dpr);
+        image.fill(Qt::transparent);
+        QPainter painter(&image);
+        painter.drawImage(QPoint(0, 0), elementImage(selected ? KMahjonggTileElements::selectedIndex(num) : num, width, height, dpr));
+        painter.drawImage(faceOffset(num), elementImage(KMahjonggTileElements::faceIndex(face), scaleddata.fw * dpr, scaleddata.fh * dpr, dpr));
+        return image;
+    });
+}
+
+QPixmap KMahjonggTilesetPrivate::compositePixmap(int num, int face, bool selected, qreal dpr, KMahjonggTileset::Rotation rotation) const
+{
+    const short width = scaleddata.w * dpr;
+    const short height = scaleddata.h * dpr;
+    const QString pixmapCacheName = compositeCacheName(num, face, selected, width, height);
+    return cachedPixmap(KMahjonggCache::TileFaces, pixmapCacheName, rotation, dpr, [this, num, face, selected, width, height, dpr]() {
+        QPixmap pixmap(width, height);
+        pixmap.setDevicePixelRatio(dpr);
+        pixmap.fill(Qt::transparent);
+        QPainter painter(&pixmap);
+        painter.drawPixmap(QPoint(0, 0), elementPixmap(KMahjonggCache::TileBodies, selected ? KMahjonggTileElements::selectedIndex(num) : num, width, height, dpr));
+        painter.drawPixmap(faceOffset(num), elementPixmap(KMahjonggCache::TileFaces, KMahjonggTileElements::faceIndex(face), scaleddata.fw * dpr, scaleddata.fh * dpr, dpr));
+        return pixmap;
+    });
+}
+
+QHash<QString, QByteArray> KMahjonggTilesetPrivate::computeElementHashes(QByteArray *sharedHash) const
+{
+    if (sharedHash) {
+        sharedHash->clear();
+    }
+    if (!isSVG) {
+        return sprites.elementHashes();
+    }
+
+    QFile file(svg.fileName());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    // compressed files would need inflating first, so all their elements count as changed
+    if (file.peek(2) == QByteArrayLiteral("\x1f\x8b")) {
+        return {};
+    }
+    return KMahjonggElementHash::subtreeHashes(&file, elementIdTable, sharedHash);
+}
+
+void KMahjonggTilesetPrivate::evictElement(int index)
+{
+    // composites and tinted selections contain the key as well
+    const QString &key = elementCacheKeys.at(index);
+    KMahjonggCachePrivate *cache = KMahjonggCachePrivate::instance();
+    cache->removeContaining(KMahjonggCache::TileBodies, key);
+    cache->removeContaining(KMahjonggCache::TileFaces, key);
+
+    imageCache.removeIf([&key](const QString &imageKey) {
+        return imageKey.contains(key);
+    });
+    mipChains.remove(key);
+}
+
+int KMahjonggTileset::prerenderElementCount() const
 {
     Q_D(const KMahjonggTileset);
 
+    return d->elementIdTable.size();
+}
+
+bool KMahjonggTileset::prerenderElement(int index, QSize tileSize, qreal devicePixelRatio) const
+{
+    Q_D(const KMahjonggTileset);
+
+    if (!d->graphicsLoaded || index < 0 || index >= d->elementIdTable.size() || d->originaldata.w <= 0) {
+        return false;
+    }
+
+    // same sizes as set up by reloadTileset(tileSize)
+    const bool isFace = KMahjonggTileElements::isFace(index);
+    const qreal ratio = static_cast<qreal>(tileSize.width()) / d->originaldata.w;
+    const short logicalWidth = isFace ? static_cast<short>(d->originaldata.fw * ratio) : tileSize.width();
+    const short logicalHeight = isFace ? static_cast<short>(d->originaldata.fh * ratio) : tileSize.height();
+    const short width = logicalWidth * devicePixelRatio;
+    const short height = logicalHeight * devicePixelRatio;
+    const KMahjonggCache::Partition partition = isFace ? KMahjonggCache::TileFaces : KMahjonggCache::TileBodies;
+
+    // only use free room, never push out what is in use
+    const KMahjonggCache::Statistics statistics = KMahjonggCache::statistics(partition);
+    const int cost = std::max(1, width * height * 4 / 1024);
+    if (statistics.cost + cost > statistics.budget) {
+        return false;
+    }
+
+    const QScopedValueRollback<bool> rollback(renderingAhead, true);
+    d->elementPixmap(partition, index, width, height, devicePixelRatio);
+    return true;
+}
+
+QPixmap KMahjonggTileset::cachedElement(int index, Rotation rotation) const
+{
+    Q_D(const KMahjonggTileset);
+
+    if (index < 0 || index >= KMahjonggTileElements::Count) {
+        return QPixmap();
+    }
+
+    // keyed like the pixmap getters do
+    const qreal dpr = KMahjonggUtils::defaultDevicePixelRatio();
+    const bool isFace = KMahjonggTileElements::isFace(index);
+    const short width = (isFace ? d->scaleddata.fw : d->scaleddata.w) * dpr;
+    const short height = (isFace ? d->scaleddata.fh : d->scaleddata.h) * dpr;
+    const KMahjonggCache::Partition partition = isFace ? KMahjonggCache::TileFaces : KMahjonggCache::TileBodies;
     QPixmap pm;
+    // called while painting, so leave the LRU order, the statistics and compressed entries alone
+    KMahjonggCachePrivate::instance()->peek(partition, d->elementCacheName(index, width, height) + rotationSuffix(rotation), &pm);
+    return pm;
+}
+
+QString KMahjonggTileset::graphicsSourcePath() const
+{
+    Q_D(const KMahjonggTileset);
+
+    return d->isSVG ? d->svg.fileName() : d->sprites.fileName();
+}
+
+void KMahjonggTileset::startElementTracking()
+{
+    Q_D(KMahjonggTileset);
+
+    d->elementHashes = d->computeElementHashes(&d->sharedContentHash);
+    d->trackedSharedContentHash = d->sharedContentHash;
+}
+
+QStringList KMahjonggTileset::reloadChangedElements()
+{
+    Q_D(KMahjonggTileset);
+
+    if (!d->graphicsLoaded) {
+        return {};
+    }
+    // a file saved half-way fails to load, then all elements are empty until the next save
+    bool isValid;
+    if (d->isSVG) {
+        isValid = d->svg.load(d->graphicspath);
+    } else {
+        isValid = d->sprites.load(d->graphicspath, d->elementIdTable);
+    }
+    QByteArray newSharedHash;
+    const QHash<QString, QByteArray> newHashes = isValid ? d->computeElementHashes(&newSharedHash) : QHash<QString, QByteArray>();
+    const QString fileName = QFileInfo(d->graphicspath).fileName();
+    ++d->reloadCount;
+    // edited gradients, <use> targets and the like can change any element
+    const bool sharedContentChanged = (newSharedHash != d->sharedContentHash);
+    // keeps keys apart from renderings with the same element content but other shared content
+    const QByteArray sharedKeyPart = (newSharedHash == d->trackedSharedContentHash) ? QByteArray() : newSharedHash;
+
+    QStringList changedElements;
+    for (int index = 0; index < d->elementIdTable.size(); ++index) {
+        const QString &elementId = d->elementIdTable.at(index);
+        const QByteArray newHash = newHashes.value(elementId);
+        if (!sharedContentChanged && !newHash.isEmpty() && newHash == d->elementHashes.value(elementId)) {
+            continue;
+        }
+        d->evictElement(index);
+        // new keys, so nothing rendered before the reload gets reused
+        d->elementCacheKeys[index] = newHash.isEmpty() ? d->name + elementId + QStringLiteral("@%1").arg(d->reloadCount) //
+                                                       : fileName + QString::fromLatin1(newHash + sharedKeyPart);
+        changedElements.append(elementId);
+    }
+    // tinted selections are derived from the unselected tiles
+    if (d->selectionTint.isValid()) {
+        for (int index = 0; index < KMahjonggTileElements::BodyCount; ++index) {
+            const QString &selectedId = d->elementIdTable.at(KMahjonggTileElements::selectedIndex(index));
+            if (changedElements.contains(d->elementIdTable.at(index)) && !changedElements.contains(selectedId)) {
+                changedElements.append(selectedId);
+            }
+        }
+    }
 
-    const qreal dpr = qApp->devicePixelRatio();
+    d->elementHashes = newHashes;
+    d->sharedContentHash = newSharedHash;
+    return changedElements;
+}
+
+void KMahjonggTileset::setSelectionTint(const QColor &color, qreal strength)
+{
+    Q_D(KMahjonggTileset);
+
+    d->selectionTint = color;
+    d->selectionTintStrength = qBound(0.0, strength, 1.0);
+    // the pixmap caches are keyed by the tint, only images of the old one are dropped here
+    d->clearImageCache();
+}
+
+QColor KMahjonggTileset::selectionTint() const
+{
+    Q_D(const KMahjonggTileset);
+
+    return d->selectionTint;
+}
+
+qreal KMahjonggTileset::selectionTintStrength() const
+{
+    Q_D(const KMahjonggTileset);
+
+    return d->selectionTintStrength;
+}
+
+QPixmap KMahjonggTileset::selectedTile(int num) const
+{
+    return selectedTile(num, Rotate0);
+}
+
+QPixmap KMahjonggTileset::unselectedTile(int num) const
+{
+    return unselectedTile(num, Rotate0);
+}
+
+QPixmap KMahjonggTileset::tileface(int num) const
+{
+    return tileface(num, Rotate0);
+}
+
+QPixmap KMahjonggTileset::selectedTile(int num, Rotation rotation) const
+{
+    Q_D(const KMahjonggTileset);
+
+    if (!KMahjonggTileElements::isValidBody(num)) {
+        return QPixmap();
+    }
+
+    const qreal dpr = KMahjonggUtils::defaultDevicePixelRatio();
     // use tile size
     const short width = d->scaleddata.w * dpr;
     const short height = d->scaleddata.h * dpr;
-    QString elemId = d->elementIdTable.at(num);
-    // using raw pixmap size with cache id, as the rendering is done dpr-ignorant
-    const  QString pixmapCacheName = d->pixmapCacheNameFromElementId(elemId, width, height);
-    if (!QPixmapCache::find(pixmapCacheName, &pm)) {
-        pm = d->renderElement(width, height, elemId);
-        pm.setDevicePixelRatio(dpr);
-        QPixmapCache::insert(pixmapCacheName, pm);
+    // selected offset in our idtable
+    return d->elementPixmap(KMahjonggCache::TileBodies, KMahjonggTileElements::selectedIndex(num), width, height, dpr, rotation);
+}
+
+QPixmap KMahjonggTileset::unselectedTile(int num, Rotation rotation) const
+{
+    Q_D(const KMahjonggTileset);
+
+    if (!KMahjonggTileElements::isValidBody(num)) {
+        return QPixmap();
     }
-    return pm;
+
+    const qreal dpr = KMahjonggUtils::defaultDevicePixelRatio();
+    // use tile size
+    const short width = d->scaleddata.w * dpr;
+    const short height = d->scaleddata.h * dpr;
+    return d->elementPixmap(KMahjonggCache::TileBodies, num, width, height, dpr, rotation);
 }
 
-QPixmap KMahjonggTileset::tileface(int num) const
+QPixmap KMahjonggTileset::tileface(int num, Rotation rotation) const
 {
     Q_D(const KMahjonggTileset);
 
-    QPixmap pm;
-    if ((num + 8) >= d->elementIdTable.count()) {
+    if (!KMahjonggTileElements::isValidFace(num)) {
         // qCDebug(LIBKMAHJONGG_LOG) << "Client asked for invalid tileface id";
-        return pm;
+        return QPixmap();
     }
 
-    const qreal dpr = qApp->devicePixelRatio();
+    const qreal dpr = KMahjonggUtils::defaultDevicePixelRatio();
     // use face size
     const short width = d->scaleddata.fw * dpr;
     const short height = d->scaleddata.fh * dpr;
-    QString elemId = d->elementIdTable.at(num + 8); // tileface offset in our idtable;
-    // using raw pixmap size with cache id, as the rendering is done dpr-ignorant
-    const  QString pixmapCacheName = d->pixmapCacheNameFromElementId(elemId, width, height);
-    if (!QPixmapCache::find(pixmapCacheName, &pm)) {
-        pm = d->renderElement(width, height, elemId);
-        pm.setDevicePixelRatio(dpr);
-        QPixmapCache::insert(pixmapCacheName, pm);
+    // tileface offset in our idtable
+    return d->elementPixmap(KMahjonggCache::TileFaces, KMahjonggTileElements::faceIndex(num), width, height, dpr, rotation);
+}
+
+QPixmap KMahjonggTileset::tile(int num, int face, bool selected, Rotation rotation) const
+{
+    Q_D(const KMahjonggTileset);
+
+    if (!KMahjonggTileElements::isValidBody(num) || !KMahjonggTileElements::isValidFace(face)) {
+        return QPixmap();
     }
-    return pm;
+
+    return d->compositePixmap(num, face, selected, KMahjonggUtils::defaultDevicePixelRatio(), rotation);
+}
+
+QPixmap KMahjonggTileset::selectedTile(TileBody body, Rotation rotation) const
+{
+    return selectedTile(static_cast<int>(body), rotation);
+}
+
+QPixmap KMahjonggTileset::unselectedTile(TileBody body, Rotation rotation) const
+{
+    return unselectedTile(static_cast<int>(body), rotation);
+}
+
+QPixmap KMahjonggTileset::tileface(TileFace face, Rotation rotation) const
+{
+    return tileface(static_cast<int>(face), rotation);
+}
+
+QPixmap KMahjonggTileset::tile(TileBody body, TileFace face, bool selected, Rotation rotation) const
+{
+    return tile(static_cast<int>(body), static_cast<int>(face), selected, rotation);
+}
+
+int KMahjonggTilesetPrivate::elementPixmaps(KMahjonggCache::Partition partition,
+                                            int firstIndex,
+                                            int available,
+                                            std::span<QPixmap> pixmaps,
+                                            short logicalWidth,
+                                            short logicalHeight,
+                                            KMahjonggTileset::Rotation rotation) const
+{
+    // same for all elements, so only looked up once
+    const qreal dpr = KMahjonggUtils::defaultDevicePixelRatio();
+    const short width = logicalWidth * dpr;
+    const short height = logicalHeight * dpr;
+    const int filled = static_cast<int>(std::min<std::size_t>(pixmaps.size(), available));
+    for (int i = 0; i < filled; ++i) {
+        pixmaps[i] = elementPixmap(partition, firstIndex + i, width, height, dpr, rotation);
+    }
+    return filled;
+}
+
+int KMahjonggTileset::selectedTiles(std::span<QPixmap> bodies, Rotation rotation) const
+{
+    Q_D(const KMahjonggTileset);
+
+    return d->elementPixmaps(KMahjonggCache::TileBodies,
+                             KMahjonggTileElements::SelectedOffset,
+                             BodyCount,
+                             bodies,
+                             d->scaleddata.w,
+                             d->scaleddata.h,
+                             rotation);
+}
+
+int KMahjonggTileset::unselectedTiles(std::span<QPixmap> bodies, Rotation rotation) const
+{
+    Q_D(const KMahjonggTileset);
+
+    return d->elementPixmaps(KMahjonggCache::TileBodies, 0, BodyCount, bodies, d->scaleddata.w, d->scaleddata.h, rotation);
+}
+
+int KMahjonggTileset::tilefaces(std::span<QPixmap> faces, Rotation rotation) const
+{
+    Q_D(const KMahjonggTileset);
+
+    return d->elementPixmaps(KMahjonggCache::TileFaces,
+                             KMahjonggTileElements::FaceOffset,
+                             FaceCount,
+                             faces,
+                             d->scaleddata.fw,
+                             d->scaleddata.fh,
+                             rotation);
+}
+
+QImage KMahjonggTileset::selectedTileImage(int num, qreal devicePixelRatio, QImage::Format format) const
+{
+    return selectedTileImage(num, devicePixelRatio, Rotate0, format);
+}
+
+QImage KMahjonggTileset::unselectedTileImage(int num, qreal devicePixelRatio, QImage::Format format) const
+{
+    return unselectedTileImage(num, devicePixelRatio, Rotate0, format);
+}
+
+QImage KMahjonggTileset::tilefaceImage(int num, qreal devicePixelRatio, QImage::Format format) const
+{
+    return tilefaceImage(num, devicePixelRatio, Rotate0, format);
+}
+
+QImage KMahjonggTileset::selectedTileImage(int num, qreal devicePixelRatio, Rotation rotation, QImage::Format format) const
+{
+    Q_D(const KMahjonggTileset);
+
+    if (!KMahjonggTileElements::isValidBody(num)) {
+        return QImage();
+    }
+
+    const short width = d->scaleddata.w * devicePixelRatio;
+    const short height = d->scaleddata.h * devicePixelRatio;
+    return KMahjonggUtils::convertedToFormat(d->elementImage(KMahjonggTileElements::selectedIndex(num), width, height, devicePixelRatio, rotation), format);
+}
+
+QImage KMahjonggTileset::unselectedTileImage(int num, qreal devicePixelRatio, Rotation rotation, QImage::Format format) const
+{
+    Q_D(const KMahjonggTileset);
+
+    if (!KMahjonggTileElements::isValidBody(num)) {
+        return QImage();
+    }
+
+    const short width = d->scaleddata.w * devicePixelRatio;
+    const short height = d->scaleddata.h * devicePixelRatio;
+    return KMahjonggUtils::convertedToFormat(d->elementImage(num, width, height, devicePixelRatio, rotation), format);
+}
+
+QImage KMahjonggTileset::tilefaceImage(int num, qreal devicePixelRatio, Rotation rotation, QImage::Format format) const
+{
+    Q_D(const KMahjonggTileset);
+
+    if (!KMahjonggTileElements::isValidFace(num)) {
+        return QImage();
+    }
+
+    const short width = d->scaleddata.fw * devicePixelRatio;
+    const short height = d->scaleddata.fh * devicePixelRatio;
+    return KMahjonggUtils::convertedToFormat(d->elementImage(KMahjonggTileElements::faceIndex(num), width, height, devicePixelRatio, rotation), format);
+}
+
+QImage KMahjonggTileset::tileImage(int num, int face, bool selected, qreal devicePixelRatio, Rotation rotation, QImage::Format format) const
+{
+    Q_D(const KMahjonggTileset);
+
+    if (!KMahjonggTileElements::isValidBody(num) || !KMahjonggTileElements::isValidFace(face)) {
+        return QImage();
+    }
+
+    return KMahjonggUtils::convertedToFormat(d->compositeImage(num, face, selected, devicePixelRatio, rotation), format);
 }
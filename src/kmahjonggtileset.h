@@ -10,10 +10,14 @@
 
 // Qt
 #include <QtClassHelperMacros> // Q_DECLARE_PRIVATE
+#include <QColor>
+#include <QImage>
 #include <QPixmap>
 #include <QString>
+#include <QStringList>
 // Std
 #include <memory>
+#include <span>
 
 // LibKMahjongg
 #include <libkmahjongg_export.h>
@@ -24,13 +28,91 @@ class KMahjonggTilesetPrivate;
  * @class KMahjonggTileset kmahjonggtileset.h <KMahjonggTileset>
  *
  * A tile set
+ *
+ * The QPixmap getters are to be used on the GUI thread only.
+ * The QImage getters may be called from any thread concurrently,
+ * as long as the tileset is not loaded or resized at the same time.
+ * Images rendered before are looked up without taking any lock,
+ * so many threads can draw from the same tileset without contention.
+ * They also work without a QGuiApplication, e.g. for headless batch rendering.
+ *
+ * Tilesets can be moved, e.g. to switch to one prepared by KMahjonggTilesetLoader.
+ * A moved-from tileset may only be assigned to or destroyed.
  */
 class LIBKMAHJONGG_EXPORT KMahjonggTileset
 {
 public:
+    /// clockwise rotation of tiles, e.g. for the walls of the other players
+    enum Rotation {
+        Rotate0 = 0,
+        Rotate90 = 90,
+        Rotate180 = 180,
+        Rotate270 = 270,
+    };
+
+    /// the tile bodies, same numbers as the int num arguments of the getters
+    enum class TileBody {
+        Body1,
+        Body2,
+        Body3,
+        Body4,
+    };
+
+    /// the tile faces, in the order of the elements of a tileset
+    enum class TileFace {
+        Character1,
+        Character2,
+        Character3,
+        Character4,
+        Character5,
+        Character6,
+        Character7,
+        Character8,
+        Character9,
+        Bamboo1,
+        Bamboo2,
+        Bamboo3,
+        Bamboo4,
+        Bamboo5,
+        Bamboo6,
+        Bamboo7,
+        Bamboo8,
+        Bamboo9,
+        Rod1,
+        Rod2,
+        Rod3,
+        Rod4,
+        Rod5,
+        Rod6,
+        Rod7,
+        Rod8,
+        Rod9,
+        Season1,
+        Season2,
+        Season3,
+        Season4,
+        Wind1,
+        Wind2,
+        Wind3,
+        Wind4,
+        Dragon1,
+        Dragon2,
+        Dragon3,
+        Flower1,
+        Flower2,
+        Flower3,
+        Flower4,
+    };
+
+    static constexpr int BodyCount = 4;
+    static constexpr int FaceCount = 42;
+
     KMahjonggTileset();
+    KMahjonggTileset(KMahjonggTileset &&other) noexcept;
     ~KMahjonggTileset();
 
+    KMahjonggTileset &operator=(KMahjonggTileset &&other) noexcept;
+
     bool loadDefault();
     bool loadTileset(const QString &tilesetPath);
     bool loadGraphics();
@@ -55,13 +137,111 @@ public:
     short qHeight() const;
     QString path() const;
 
+    /**
+     * Calculates the top-left corners of the bodies of many tiles in one pass.
+     *
+     * The input is given as separate arrays of cell coordinates, in quarter cells and levels.
+     * Higher levels are shifted as done by KMahjonggBoardCompositor for a board
+     * with @p levels levels, using tile body @p variant.
+     * @return false, leaving @p left and @p top untouched, if the sizes of the spans differ
+     */
+    bool tilePositions(std::span<const int> x,
+                       std::span<const int> y,
+                       std::span<const int> level,
+                       std::span<int> left,
+                       std::span<int> top,
+                       int variant = 0,
+                       int levels = 1) const;
+
+    /**
+     * Derives the selected tiles from the unselected ones by tinting them with @p color,
+     * instead of rendering the TILE_n_SEL elements of the tileset.
+     * An invalid @p color switches back to rendering those elements.
+     *
+     * Tilesets can declare a default with the SelectionTint (colour) and
+     * SelectionTintStrength (percent) keys of their .desktop file,
+     * which is applied again with loadTileset().
+     * @param strength from 0.0 (unchanged) to 1.0 (plain @p color)
+     */
+    void setSelectionTint(const QColor &color, qreal strength = 0.5);
+    QColor selectionTint() const;
+    qreal selectionTintStrength() const;
+
     QPixmap selectedTile(int num) const;
     QPixmap unselectedTile(int num) const;
     QPixmap tileface(int num) const;
 
+    /**
+     * Rotated variants, rotated once from the upright ones and cached per size,
+     * so they can be drawn without any transformation.
+     */
+    QPixmap selectedTile(int num, Rotation rotation) const;
+    QPixmap unselectedTile(int num, Rotation rotation) const;
+    QPixmap tileface(int num, Rotation rotation) const;
+    /**
+     * Tile body @p num with tile face @p face on it, placed like done by KMahjonggBoardCompositor.
+     */
+    QPixmap tile(int num, int face, bool selected, Rotation rotation = Rotate0) const;
+
+    QPixmap selectedTile(TileBody body, Rotation rotation = Rotate0) const;
+    QPixmap unselectedTile(TileBody body, Rotation rotation = Rotate0) const;
+    QPixmap tileface(TileFace face, Rotation rotation = Rotate0) const;
+    QPixmap tile(TileBody body, TileFace face, bool selected, Rotation rotation = Rotate0) const;
+
+    /**
+     * Fill @p bodies with the first selected, resp. unselected tile bodies,
+     * at the current tile size.
+     * @return the number of pixmaps set, the size of @p bodies but at most BodyCount
+     */
+    int selectedTiles(std::span<QPixmap> bodies, Rotation rotation = Rotate0) const;
+    int unselectedTiles(std::span<QPixmap> bodies, Rotation rotation = Rotate0) const;
+    /**
+     * Fill @p faces with the first tile faces, in TileFace order.
+     * @return the number of pixmaps set, the size of @p faces but at most FaceCount
+     */
+    int tilefaces(std::span<QPixmap> faces, Rotation rotation = Rotate0) const;
+
+    QImage selectedTileImage(int num, qreal devicePixelRatio, QImage::Format format = QImage::Format_ARGB32_Premultiplied) const;
+    QImage unselectedTileImage(int num, qreal devicePixelRatio, QImage::Format format = QImage::Format_ARGB32_Premultiplied) const;
+    QImage tilefaceImage(int num, qreal devicePixelRatio, QImage::Format format = QImage::Format_ARGB32_Premultiplied) const;
+
+    QImage selectedTileImage(int num, qreal devicePixelRatio, Rotation rotation, QImage::Format format = QImage::Format_ARGB32_Premultiplied) const;
+    QImage unselectedTileImage(int num, qreal devicePixelRatio, Rotation rotation, QImage::Format format = QImage::Format_ARGB32_Premultiplied) const;
+    QImage tilefaceImage(int num, qreal devicePixelRatio, Rotation rotation, QImage::Format format = QImage::Format_ARGB32_Premultiplied) const;
+    QImage tileImage(int num,
+                     int face,
+                     bool selected,
+                     qreal devicePixelRatio,
+                     Rotation rotation = Rotate0,
+                     QImage::Format format = QImage::Format_ARGB32_Premultiplied) const;
+
+private:
+    // for KMahjonggTilesetLoader, only uses the thread-safe image caches
+    bool prepareGraphics(QSize tileSize, qreal devicePixelRatio);
+
+    // for KMahjonggPrerenderer
+    int prerenderElementCount() const;
+    bool prerenderElement(int index, QSize tileSize, qreal devicePixelRatio) const;
+
+    // for KMahjonggRenderQueue, a null pixmap if not in the pixmap cache, never renders
+    QPixmap cachedElement(int index, Rotation rotation) const;
+
+    // for KMahjonggBoardMetrics, unlike 2 * qWidth() exact for odd face sizes
+    QSize faceSize() const;
+
+    // for KMahjonggThemeWatcher
+    QString graphicsSourcePath() const;
+    void startElementTracking();
+    QStringList reloadChangedElements();
+
 private:
     friend class KMahjonggTilesetPrivate;
-    std::unique_ptr<KMahjonggTilesetPrivate> const d_ptr;
+    friend class KMahjonggBoardMetrics;
+    friend class KMahjonggPrerenderer;
+    friend class KMahjonggRenderQueue;
+    friend class KMahjonggThemeWatcher;
+    friend class KMahjonggTilesetLoader;
+    std::unique_ptr<KMahjonggTilesetPrivate> d_ptr;
     Q_DECLARE_PRIVATE(KMahjonggTileset)
     Q_DISABLE_COPY(KMahjonggTileset)
 };
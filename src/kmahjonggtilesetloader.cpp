@@ -0,0 +1,113 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+// own
+#include "kmahjonggtilesetloader.h"
+
+// Qt
+#include <QThreadPool>
+
+// LibKMahjongg
+#include "kmahjonggcache.h"
+#include "kmahjonggtileset.h"
+#include "kmahjonggutils_p.h"
+
+class KMahjonggTilesetLoaderPrivate
+{
+public:
+    KMahjonggTilesetLoaderPrivate()
+    {
+        // loads are started one after the other, an abandoned running one only finishes its work
+        pool.setMaxThreadCount(1);
+    }
+
+public:
+    QThreadPool pool;
+    std::unique_ptr<KMahjonggTileset> tileset;
+    // increased with every load(), results of older loads are dropped
+    quint64 generation = 0;
+    bool loading = false;
+};
+
+KMahjonggTilesetLoader::KMahjonggTilesetLoader(QObject *parent)
+    : QObject(parent)
+    , d_ptr(new KMahjonggTilesetLoaderPrivate)
+{
+}
+
+KMahjonggTilesetLoader::~KMahjonggTilesetLoader()
+{
+    Q_D(KMahjonggTilesetLoader);
+
+    d->pool.waitForDone();
+}
+
+void KMahjonggTilesetLoader::load(const QString &tilesetPath, QSize tileSize, qreal devicePixelRatio)
+{
+    Q_D(KMahjonggTilesetLoader);
+
+    d->tileset.reset();
+    const quint64 generation = ++d->generation;
+    d->loading = true;
+    const qreal dpr = (devicePixelRatio > 0) ? devicePixelRatio : KMahjonggUtils::defaultDevicePixelRatio();
+
+    // a superseded load not started yet is dropped, so quickly browsing tilesets only renders the last one
+    d->pool.clear();
+    d->pool.start([this, tilesetPath, tileSize, dpr, generation]() {
+        // owned by the job until handed over to the GUI thread
+        auto tileset = std::make_shared<KMahjonggTileset>();
+        const bool success = tileset->loadTileset(tilesetPath) && tileset->prepareGraphics(tileSize, dpr);
+
+        // the loader outlives the job, as its destructor waits for it
+        QMetaObject::invokeMethod(
+            this,
+            [this, tileset, success, generation]() {
+                Q_D(KMahjonggTilesetLoader);
+
+                if (generation != d->generation) {
+                    return;
+                }
+                d->loading = false;
+                if (success) {
+                    d->tileset = std::make_unique<KMahjonggTileset>(std::move(*tileset));
+                }
+                Q_EMIT finished(success);
+            },
+            Qt::QueuedConnection);
+    });
+}
+
+bool KMahjonggTilesetLoader::isLoading() const
+{
+    Q_D(const KMahjonggTilesetLoader);
+
+    return d->loading;
+}
+
+bool KMahjonggTilesetLoader::hasTileset() const
+{
+    Q_D(const KMahjonggTilesetLoader);
+
+    return static_cast<bool>(d->tileset);
+}
+
+KMahjonggTileset KMahjonggTilesetLoader::takeTileset()
+{
+    Q_D(KMahjonggTilesetLoader);
+
+    if (!d->tileset) {
+        return KMahjonggTileset();
+    }
+
+    KMahjonggTileset tileset(std::move(*d->tileset));
+    d->tileset.reset();
+    // like done by KMahjonggTileset::loadGraphics(), which could not be done on the worker thread
+    KMahjonggCache::clear(KMahjonggCache::TileBodies);
+    KMahjonggCache::clear(KMahjonggCache::TileFaces);
+    return tileset;
+}
+
+#include "moc_kmahjonggtilesetloader.cpp"
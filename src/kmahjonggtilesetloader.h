@@ -0,0 +1,80 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef KMAHJONGGTILESETLOADER_H
+#define KMAHJONGGTILESETLOADER_H
+
+// Qt
+#include <QObject>
+#include <QSize>
+// Std
+#include <memory>
+
+// LibKMahjongg
+#include <libkmahjongg_export.h>
+
+class KMahjonggTileset;
+class KMahjonggTilesetLoaderPrivate;
+
+/**
+ * @class KMahjonggTilesetLoader kmahjonggtilesetloader.h <KMahjonggTilesetLoader>
+ *
+ * Prepares a tileset on a worker thread, so switching to it does not stall the GUI.
+ *
+ * The metadata and graphics are loaded and the tile images are rendered for the given
+ * tile size, all without touching the tileset in use. Once finished() is emitted,
+ * the prepared tileset can be moved into the one in use:
+ * @code
+ * connect(loader, &KMahjonggTilesetLoader::finished, this, [this](bool success) {
+ *     if (success) {
+ *         m_tileset = m_loader->takeTileset();
+ *         update();
+ *     }
+ * });
+ * m_loader->load(Prefs::tileSet(), QSize(m_tileset.width(), m_tileset.height()));
+ * @endcode
+ * KMahjonggConfigDialog does not use the loader, as it does not know the tileset of the game.
+ * Applications wanting tileset switches without stalls have to call load() themselves,
+ * e.g. from the slot connected to KConfigDialog::settingsChanged().
+ * To be used on the GUI thread.
+ */
+class LIBKMAHJONGG_EXPORT KMahjonggTilesetLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit KMahjonggTilesetLoader(QObject *parent = nullptr);
+    /// waits for a running load to finish
+    ~KMahjonggTilesetLoader() override;
+
+    /**
+     * Starts preparing the tileset with the .desktop file @p tilesetPath.
+     * A load not started yet is cancelled, one still running is abandoned,
+     * as is a prepared tileset not yet taken.
+     * @param tileSize as passed to KMahjonggTileset::reloadTileset(), if empty the original size is used
+     * @param devicePixelRatio the images are rendered for, if 0 the one of the application
+     */
+    void load(const QString &tilesetPath, QSize tileSize, qreal devicePixelRatio = 0);
+    bool isLoading() const;
+
+    bool hasTileset() const;
+    /**
+     * @return the prepared tileset, or a tileset not loaded if there is none.
+     * Drops the pixmaps cached for the previous tileset.
+     */
+    KMahjonggTileset takeTileset();
+
+Q_SIGNALS:
+    /// the load started last is done, with @p success if a tileset is ready to be taken
+    void finished(bool success);
+
+private:
+    std::unique_ptr<KMahjonggTilesetLoaderPrivate> const d_ptr;
+    Q_DECLARE_PRIVATE(KMahjonggTilesetLoader)
+    Q_DISABLE_COPY(KMahjonggTilesetLoader)
+};
+
+#endif // KMAHJONGGTILESETLOADER_H
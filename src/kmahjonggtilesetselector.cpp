@@ -8,15 +8,14 @@
 #include "kmahjonggtilesetselector.h"
 
 // Qt
-#include <QDir>
 #include <QPainter>
-#include <QStandardPaths>
 
 // KF
 #include <KAboutLicense>
 #include <KLocalizedString>
 
 // LibKMahjongg
+#include "kmahjonggthememodel_p.h"
 #include "kmahjonggtileset.h"
 
 KMahjonggTilesetSelector::KMahjonggTilesetSelector(QWidget *parent, KConfigSkeleton *aconfig)
@@ -26,10 +25,7 @@ KMahjonggTilesetSelector::KMahjonggTilesetSelector(QWidget *parent, KConfigSkele
     setupData(aconfig);
 }
 
-KMahjonggTilesetSelector::~KMahjonggTilesetSelector()
-{
-    qDeleteAll(tilesetMap);
-}
+KMahjonggTilesetSelector::~KMahjonggTilesetSelector() = default;
 
 void KMahjonggTilesetSelector::setupData(KConfigSkeleton *aconfig)
 {
@@ -41,70 +37,50 @@ void KMahjonggTilesetSelector::setupData(KConfigSkeleton *aconfig)
     // The lineEdit widget holds our tileset path, but the user does not manipulate it directly
     kcfg_TileSet->hide();
 
-    // This will also load our resourcedir if it is not done already
-    KMahjonggTileset tile;
-
-    // Now get our tilesets into a list
-    QStringList tilesAvailable;
-    const QStringList dirs =
-        QStandardPaths::locateAll(QStandardPaths::GenericDataLocation, QStringLiteral("kmahjongglib/tilesets"), QStandardPaths::LocateDirectory);
-    for (const QString &dir : dirs) {
-        const QStringList fileNames = QDir(dir).entryList({QStringLiteral("*.desktop")});
-        tilesAvailable.reserve(tilesAvailable.size() + fileNames.size());
-        for (const QString &file : fileNames) {
-            tilesAvailable.append(dir + QLatin1Char('/') + file);
-        }
-    }
+    // Tilesets are only read when their row gets shown or selected
+    tilesetModel = new KMahjonggThemeModel(KMahjonggThemeModel::Tilesets, this);
+    tilesetList->setModel(tilesetModel);
 
-    int numvalidentries = 0;
-    for (const QString &atileset : std::as_const(tilesAvailable)) {
-        auto *aset = new KMahjonggTileset();
-        if (aset->loadTileset(atileset)) {
-            const QString name = aset->name();
-            tilesetMap.insert(name, aset);
-            tilesetList->addItem(name);
-            // Find if this is our currently configured Tileset
-            if (atileset == initialGroup) {
-                // Select current entry
-                tilesetList->setCurrentRow(numvalidentries);
-                tilesetChanged();
-            }
-            ++numvalidentries;
-        } else {
-            delete aset;
-        }
-    }
+    connect(tilesetList->selectionModel(), &QItemSelectionModel::currentChanged, this, &KMahjonggTilesetSelector::tilesetChanged);
 
-    connect(tilesetList, &QListWidget::currentItemChanged, this, &KMahjonggTilesetSelector::tilesetChanged);
+    // Find if we have our currently configured Tileset
+    const int initialRow = tilesetModel->rowForPath(initialGroup);
+    if (initialRow >= 0) {
+        // Select current entry
+        tilesetList->setCurrentIndex(tilesetModel->index(initialRow));
+    }
 }
 
 void KMahjonggTilesetSelector::tilesetChanged()
 {
-    KMahjonggTileset *selTileset = tilesetMap.value(tilesetList->currentItem()->text());
+    const QModelIndex current = tilesetList->currentIndex();
     // Sanity checkings. Should not happen.
-    if (selTileset == nullptr) {
+    if (!current.isValid()) {
         return;
     }
-    if (selTileset->path() == kcfg_TileSet->text()) {
+    const QString path = current.data(KMahjonggThemeModel::PathRole).toString();
+    if (path == kcfg_TileSet->text()) {
         return;
     }
 
-    kcfg_TileSet->setText(selTileset->path());
-    tilesetAuthor->setText(selTileset->authorName());
-    tilesetContact->setText(selTileset->authorEmailAddress());
-    tilesetDescription->setText(selTileset->description());
-    tilesetVersion->setText(selTileset->version());
-    QString website = selTileset->website();
+    kcfg_TileSet->setText(path);
+    tilesetAuthor->setText(current.data(KMahjonggThemeModel::AuthorRole).toString());
+    tilesetContact->setText(current.data(KMahjonggThemeModel::AuthorEmailRole).toString());
+    tilesetDescription->setText(current.data(KMahjonggThemeModel::DescriptionRole).toString());
+    tilesetVersion->setText(current.data(KMahjonggThemeModel::VersionRole).toString());
+    QString website = current.data(KMahjonggThemeModel::WebsiteRole).toString();
     if (!website.isEmpty()) {
         website = QLatin1String("<a href=\"") + website + QLatin1String("\">") + website + QLatin1String("</a>");
     }
     tilesetWebsite->setText(website);
-    tilesetCopyright->setText(selTileset->copyrightText());
-    const QString licenseName = KAboutLicense::byKeyword(selTileset->license()).name(KAboutLicense::FullName);
+    tilesetCopyright->setText(current.data(KMahjonggThemeModel::CopyrightRole).toString());
+    const QString licenseName = KAboutLicense::byKeyword(current.data(KMahjonggThemeModel::LicenseRole).toString()).name(KAboutLicense::FullName);
     tilesetLicense->setText(licenseName);
 
     // Make sure SVG is loaded when graphics is selected
-    if (!selTileset->loadGraphics()) {
+    KMahjonggTileset *selTileset = tilesetModel->tileset(current.row());
+    if (selTileset == nullptr) {
+        tilesetPreview->setPixmap(QPixmap());
         return;
     }
     const qreal dpr = qApp->devicePixelRatio();
@@ -7,16 +7,13 @@
 #ifndef KMAHJONGGTILESETSELECTOR_H
 #define KMAHJONGGTILESETSELECTOR_H
 
-// Qt
-#include <QHash>
-
 // KF
 #include <KConfigSkeleton>
 
 // LibKMahjongg
 #include "ui_kmahjonggtilesetselector.h"
 
-class KMahjonggTileset;
+class KMahjonggThemeModel;
 
 class KMahjonggTilesetSelector : public QWidget, private Ui::KMahjonggTilesetSelector
 {
@@ -32,7 +29,7 @@ public Q_SLOTS:
     void tilesetChanged();
 
 private:
-    QHash<QString, KMahjonggTileset *> tilesetMap;
+    KMahjonggThemeModel *tilesetModel = nullptr;
 };
 
 #endif // KMAHJONGGTILESETSELECTOR_H
@@ -0,0 +1,41 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef KMAHJONGGUTILS_P_H
+#define KMAHJONGGUTILS_P_H
+
+// Qt
+#include <QGuiApplication>
+#include <QImage>
+
+namespace KMahjonggUtils
+{
+
+/**
+ * Device pixel ratio of the GUI application, or 1.0 if there is none,
+ * e.g. when rendering headless from a QCoreApplication.
+ */
+inline qreal defaultDevicePixelRatio()
+{
+    const auto *guiApp = qobject_cast<QGuiApplication *>(QCoreApplication::instance());
+    return guiApp ? guiApp->devicePixelRatio() : 1.0;
+}
+
+/**
+ * QPainter renders fastest into premultiplied ARGB32, so all rendering happens
+ * in that format and other formats are only converted to on output.
+ */
+inline QImage convertedToFormat(QImage &&image, QImage::Format format)
+{
+    if (image.isNull() || image.format() == format) {
+        return std::move(image);
+    }
+    return std::move(image).convertToFormat(format);
+}
+
+}
+
+#endif // KMAHJONGGUTILS_P_H
@@ -0,0 +1,288 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+// own
+#include "kmahjonggvisibilityindex.h"
+
+// Qt
+#include <QRegion>
+// Std
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+// LibKMahjongg
+#include "kmahjonggboardgeometry_p.h"
+
+namespace
+{
+struct IndexedTile {
+    KMahjonggTilePlacement placement;
+    KMahjonggVisibilityIndex::Visibility visibility = KMahjonggVisibilityIndex::FullyVisible;
+    bool present = true;
+};
+}
+
+class KMahjonggVisibilityIndexPrivate
+{
+public:
+    explicit KMahjonggVisibilityIndexPrivate(const KMahjonggTileset *tileset)
+        : tileset(tileset)
+    {
+    }
+
+    bool ensureUpToDate();
+    void rebuild();
+    void bucketRange(const QRect &rect, int *x0, int *y0, int *x1, int *y1) const;
+    void insertIntoBuckets(int id);
+    void removeFromBuckets(int id);
+    std::vector<int> tilesIntersecting(const QRect &rect) const;
+    KMahjonggVisibilityIndex::Visibility computeVisibility(int id) const;
+    void updateTilesBelow(int id);
+
+public:
+    const KMahjonggTileset *tileset;
+    KMahjonggBoardGeometry geometry;
+
+    std::vector<IndexedTile> tiles;
+    QList<int> changedTiles;
+
+    // tile ids by area of the board, with buckets of tile size
+    std::vector<std::vector<int>> buckets;
+    int bucketColumns = 0;
+    int bucketRows = 0;
+    bool needsRebuild = true;
+};
+
+bool KMahjonggVisibilityIndexPrivate::ensureUpToDate()
+{
+    const KMahjonggBoardMetrics metrics = KMahjonggBoardMetrics::fromTileset(tileset);
+    if (!(metrics == geometry.metrics)) {
+        // the tileset got resized
+        geometry.metrics = metrics;
+        needsRebuild = true;
+    }
+    if (!needsRebuild) {
+        return false;
+    }
+    rebuild();
+    return true;
+}
+
+void KMahjonggVisibilityIndexPrivate::rebuild()
+{
+    needsRebuild = false;
+
+    const QSize boardSize = geometry.boardSize();
+    bucketColumns = std::max(1, boardSize.width() / std::max<int>(1, geometry.metrics.w) + 1);
+    bucketRows = std::max(1, boardSize.height() / std::max<int>(1, geometry.metrics.h) + 1);
+    buckets.assign(bucketColumns * bucketRows, std::vector<int>());
+
+    for (int id = 0; id < static_cast<int>(tiles.size()); ++id) {
+        if (tiles[id].present) {
+            insertIntoBuckets(id);
+        }
+    }
+    for (int id = 0; id < static_cast<int>(tiles.size()); ++id) {
+        if (tiles[id].present) {
+            tiles[id].visibility = computeVisibility(id);
+        }
+    }
+}
+
+void KMahjonggVisibilityIndexPrivate::bucketRange(const QRect &rect, int *x0, int *y0, int *x1, int *y1) const
+{
+    const int bucketWidth = std::max<int>(1, geometry.metrics.w);
+    const int bucketHeight = std::max<int>(1, geometry.metrics.h);
+    *x0 = std::clamp(rect.left() / bucketWidth, 0, bucketColumns - 1);
+    *x1 = std::clamp(rect.right() / bucketWidth, 0, bucketColumns - 1);
+    *y0 = std::clamp(rect.top() / bucketHeight, 0, bucketRows - 1);
+    *y1 = std::clamp(rect.bottom() / bucketHeight, 0, bucketRows - 1);
+}
+
+void KMahjonggVisibilityIndexPrivate::insertIntoBuckets(int id)
+{
+    int x0, y0, x1, y1;
+    bucketRange(geometry.tileRect(tiles[id].placement), &x0, &y0, &x1, &y1);
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            buckets[y * bucketColumns + x].push_back(id);
+        }
+    }
+}
+
+void KMahjonggVisibilityIndexPrivate::removeFromBuckets(int id)
+{
+    int x0, y0, x1, y1;
+    bucketRange(geometry.tileRect(tiles[id].placement), &x0, &y0, &x1, &y1);
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            std::vector<int> &bucket = buckets[y * bucketColumns + x];
+            bucket.erase(std::remove(bucket.begin(), bucket.end(), id), bucket.end());
+        }
+    }
+}
+
+std::vector<int> KMahjonggVisibilityIndexPrivate::tilesIntersecting(const QRect &rect) const
+{
+    std::vector<int> result;
+    int x0, y0, x1, y1;
+    bucketRange(rect, &x0, &y0, &x1, &y1);
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            for (const int id : buckets[y * bucketColumns + x]) {
+                if (geometry.tileRect(tiles[id].placement).intersects(rect)) {
+                    result.push_back(id);
+                }
+            }
+        }
+    }
+    // tiles can be in several buckets
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+KMahjonggVisibilityIndex::Visibility KMahjonggVisibilityIndexPrivate::computeVisibility(int id) const
+{
+    const KMahjonggTilePlacement &tile = tiles[id].placement;
+    const QRect rect = geometry.tileRect(tile);
+    if (rect.isEmpty()) {
+        return KMahjonggVisibilityIndex::FullyVisible;
+    }
+
+    QRegion covered;
+    for (const int otherId : tilesIntersecting(rect)) {
+        if (otherId == id || !geometry.drawsBefore(tile, tiles[otherId].placement)) {
+            continue;
+        }
+        covered += geometry.opaqueRect(tiles[otherId].placement) & rect;
+    }
+
+    if (covered.isEmpty()) {
+        return KMahjonggVisibilityIndex::FullyVisible;
+    }
+    if ((QRegion(rect) - covered).isEmpty()) {
+        return KMahjonggVisibilityIndex::Hidden;
+    }
+    return KMahjonggVisibilityIndex::PartiallyVisible;
+}
+
+void KMahjonggVisibilityIndexPrivate::updateTilesBelow(int id)
+{
+    const KMahjonggTilePlacement &tile = tiles[id].placement;
+    for (const int otherId : tilesIntersecting(geometry.tileRect(tile))) {
+        IndexedTile &other = tiles[otherId];
+        if (otherId == id || !geometry.drawsBefore(other.placement, tile)) {
+            continue;
+        }
+        const KMahjonggVisibilityIndex::Visibility visibility = computeVisibility(otherId);
+        if (visibility != other.visibility) {
+            other.visibility = visibility;
+            if (!changedTiles.contains(otherId)) {
+                changedTiles.append(otherId);
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------
+
+KMahjonggVisibilityIndex::KMahjonggVisibilityIndex(const KMahjonggTileset *tileset)
+    : d_ptr(new KMahjonggVisibilityIndexPrivate(tileset))
+{
+}
+
+KMahjonggVisibilityIndex::~KMahjonggVisibilityIndex() = default;
+
+void KMahjonggVisibilityIndex::setTileVariant(int variant)
+{
+    Q_D(KMahjonggVisibilityIndex);
+
+    if (variant == d->geometry.variant || variant < 0 || variant > 3) {
+        return;
+    }
+    d->geometry.variant = variant;
+    d->needsRebuild = true;
+}
+
+void KMahjonggVisibilityIndex::setBoardSize(int columns, int rows, int levels)
+{
+    Q_D(KMahjonggVisibilityIndex);
+
+    d->geometry.columns = columns;
+    d->geometry.rows = rows;
+    d->geometry.levels = std::max(1, levels);
+    d->needsRebuild = true;
+}
+
+void KMahjonggVisibilityIndex::setTiles(const QList<KMahjonggTilePlacement> &tiles)
+{
+    Q_D(KMahjonggVisibilityIndex);
+
+    d->tiles.clear();
+    d->tiles.reserve(tiles.size());
+    for (const KMahjonggTilePlacement &tile : tiles) {
+        d->tiles.push_back({tile, FullyVisible, true});
+    }
+    d->changedTiles.clear();
+    d->needsRebuild = true;
+}
+
+int KMahjonggVisibilityIndex::addTile(const KMahjonggTilePlacement &tile)
+{
+    Q_D(KMahjonggVisibilityIndex);
+
+    const int id = static_cast<int>(d->tiles.size());
+    d->tiles.push_back({tile, FullyVisible, true});
+    // a rebuild takes care of the new tile as well
+    if (d->ensureUpToDate()) {
+        return id;
+    }
+
+    d->insertIntoBuckets(id);
+    d->tiles[id].visibility = d->computeVisibility(id);
+    d->updateTilesBelow(id);
+    return id;
+}
+
+void KMahjonggVisibilityIndex::removeTile(int id)
+{
+    Q_D(KMahjonggVisibilityIndex);
+
+    if (id < 0 || id >= static_cast<int>(d->tiles.size()) || !d->tiles[id].present) {
+        return;
+    }
+
+    d->ensureUpToDate();
+    d->removeFromBuckets(id);
+    d->tiles[id].present = false;
+    d->updateTilesBelow(id);
+}
+
+KMahjonggVisibilityIndex::Visibility KMahjonggVisibilityIndex::visibility(int id) const
+{
+    // lazy update on resize of the tileset, not visible from the outside
+    auto *d = const_cast<KMahjonggVisibilityIndexPrivate *>(d_ptr.get());
+
+    if (id < 0 || id >= static_cast<int>(d->tiles.size()) || !d->tiles[id].present) {
+        return Hidden;
+    }
+    d->ensureUpToDate();
+    return d->tiles[id].visibility;
+}
+
+bool KMahjonggVisibilityIndex::isHidden(int id) const
+{
+    return visibility(id) == Hidden;
+}
+
+QList<int> KMahjonggVisibilityIndex::takeChangedTiles()
+{
+    Q_D(KMahjonggVisibilityIndex);
+
+    return std::exchange(d->changedTiles, QList<int>());
+}
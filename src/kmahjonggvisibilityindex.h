@@ -0,0 +1,69 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef KMAHJONGGVISIBILITYINDEX_H
+#define KMAHJONGGVISIBILITYINDEX_H
+
+// Qt
+#include <QtClassHelperMacros> // Q_DECLARE_PRIVATE
+#include <QList>
+// Std
+#include <memory>
+
+// LibKMahjongg
+#include "kmahjonggboardcompositor.h"
+#include <libkmahjongg_export.h>
+
+class KMahjonggTileset;
+class KMahjonggVisibilityIndexPrivate;
+
+/**
+ * @class KMahjonggVisibilityIndex kmahjonggvisibilityindex.h <KMahjonggVisibilityIndex>
+ *
+ * Tracks which tiles of a board of stacked tiles are covered by the tiles above them.
+ *
+ * Tiles are identified by ids, given in the order of setTiles() and addTile(),
+ * like with KMahjonggBoardCompositor. Hidden tiles need neither be drawn nor
+ * their faces be rendered. Removing a tile only updates the tiles below it.
+ */
+class LIBKMAHJONGG_EXPORT KMahjonggVisibilityIndex
+{
+public:
+    enum Visibility {
+        Hidden,
+        PartiallyVisible,
+        FullyVisible,
+    };
+
+    explicit KMahjonggVisibilityIndex(const KMahjonggTileset *tileset);
+    ~KMahjonggVisibilityIndex();
+
+    /// as KMahjonggBoardCompositor::setTileVariant()
+    void setTileVariant(int variant);
+    /// as KMahjonggBoardCompositor::setBoardSize()
+    void setBoardSize(int columns, int rows, int levels);
+
+    void setTiles(const QList<KMahjonggTilePlacement> &tiles);
+    /// @return the id of the added tile
+    int addTile(const KMahjonggTilePlacement &tile);
+    void removeTile(int id);
+
+    Visibility visibility(int id) const;
+    bool isHidden(int id) const;
+
+    /**
+     * @return the ids of the tiles whose visibility changed since the last call,
+     * due to added or removed tiles
+     */
+    QList<int> takeChangedTiles();
+
+private:
+    std::unique_ptr<KMahjonggVisibilityIndexPrivate> const d_ptr;
+    Q_DECLARE_PRIVATE(KMahjonggVisibilityIndex)
+    Q_DISABLE_COPY(KMahjonggVisibilityIndex)
+};
+
+#endif // KMAHJONGGVISIBILITYINDEX_H
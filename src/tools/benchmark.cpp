@@ -0,0 +1,411 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QImage>
+#include <QPainter>
+#include <QRandomGenerator>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QString>
+#include <QSvgRenderer>
+#include <QThread>
+
+#include "kmahjonggbackground.h"
+#include "kmahjonggdisplaylist_p.h"
+#include "kmahjonggsnapshotcache_p.h"
+#include "kmahjonggtileelements_p.h"
+#include "kmahjonggtileset.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace Qt::Literals;
+
+namespace
+{
+
+struct BenchmarkOptions {
+    QString tilesetPath;
+    int tileCount = 0;
+    int iterations = 0; // 0 for the default of the benchmark
+    int threadCount = 0;
+    int writerCount = 0;
+
+    int iterationsOr(int defaultIterations) const
+    {
+        return iterations > 0 ? iterations : defaultIterations;
+    }
+};
+
+bool loadTileset(KMahjonggTileset &tileset, const QString &path)
+{
+    const bool loaded = path.isEmpty() ? tileset.loadDefault() : tileset.loadTileset(path);
+    if (!loaded || !tileset.loadGraphics()) {
+        std::cerr << "Could not load tileset " << qPrintable(path) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void printResult(const char *name, qint64 nanoSeconds, int iterations, int itemCount)
+{
+    std::cout << name << ": " << (nanoSeconds / iterations / 1000.0) << " us per run, " //
+              << (static_cast<double>(nanoSeconds) / iterations / itemCount) << " ns per tile" << std::endl;
+}
+
+void printLoadResult(const QString &theme, const char *name, qint64 coldNanoSeconds, qint64 warmNanoSeconds, int iterations)
+{
+    std::cout << qPrintable(theme) << ", " << name << ": cold " << (coldNanoSeconds / 1000000.0) << " ms, warm " //
+              << (warmNanoSeconds / iterations / 1000000.0) << " ms" << std::endl;
+}
+
+QStringList installedThemes(const QString &subDir)
+{
+    QStringList themes;
+    const QStringList dirs = QStandardPaths::locateAll(QStandardPaths::GenericDataLocation, u"kmahjongglib/"_s + subDir, QStandardPaths::LocateDirectory);
+    for (const QString &dir : dirs) {
+        const QStringList fileNames = QDir(dir).entryList({u"*.desktop"_s});
+        for (const QString &fileName : fileNames) {
+            themes.append(dir + u'/' + fileName);
+        }
+    }
+    return themes;
+}
+
+// the installed compressed file, as parsed before the library preferred uncompressed files
+QString installedGraphicsFile(const QString &theme, const QString &group, const QString &subDir)
+{
+    const QString fileName = QSettings(theme, QSettings::IniFormat).value(group + u"/FileName"_s).toString();
+    if (fileName.isEmpty()) {
+        return QString();
+    }
+    return QStandardPaths::locate(QStandardPaths::GenericDataLocation, u"kmahjongglib/"_s + subDir + u'/' + fileName);
+}
+
+// times the first load in this process and the average of further loads,
+// for really cold loads the OS file caches need to be dropped before
+template<typename Load>
+void benchmarkThemeLoad(const QString &theme, const char *name, int iterations, Load load)
+{
+    QElapsedTimer timer;
+    timer.start();
+    load();
+    const qint64 cold = timer.nsecsElapsed();
+
+    timer.start();
+    for (int iteration = 0; iteration < iterations; ++iteration) {
+        load();
+    }
+    printLoadResult(theme, name, cold, timer.nsecsElapsed(), iterations);
+}
+
+int benchmarkLoad(const BenchmarkOptions &options)
+{
+    const int iterations = options.iterationsOr(10);
+
+    for (const QString &theme : installedThemes(u"tilesets"_s)) {
+        const QString svgzFile = installedGraphicsFile(theme, u"KMahjonggTileset"_s, u"tilesets"_s);
+        if (svgzFile.isEmpty()) {
+            continue;
+        }
+        benchmarkThemeLoad(theme, "QSvgRenderer from file", iterations, [&svgzFile]() {
+            QSvgRenderer renderer(svgzFile);
+        });
+        benchmarkThemeLoad(theme, "loadGraphics()", iterations, [&theme]() {
+            KMahjonggTileset tileset;
+            tileset.loadTileset(theme);
+            tileset.loadGraphics();
+        });
+    }
+
+    for (const QString &theme : installedThemes(u"backgrounds"_s)) {
+        const QString svgzFile = installedGraphicsFile(theme, u"KMahjonggBackground"_s, u"backgrounds"_s);
+        if (svgzFile.isEmpty()) {
+            // plain colour
+            continue;
+        }
+        benchmarkThemeLoad(theme, "QSvgRenderer from file", iterations, [&svgzFile]() {
+            QSvgRenderer renderer(svgzFile);
+        });
+        benchmarkThemeLoad(theme, "loadGraphics()", iterations, [&theme]() {
+            KMahjonggBackground background;
+            background.load(theme, 100, 100);
+            background.loadGraphics();
+        });
+    }
+    return 0;
+}
+
+int benchmarkLayout(const BenchmarkOptions &options)
+{
+    KMahjonggTileset tileset;
+    if (!loadTileset(tileset, options.tilesetPath)) {
+        return -1;
+    }
+
+    const int count = options.tileCount;
+    const int iterations = options.iterationsOr(1000);
+    constexpr int levels = 8;
+    std::vector<int> x(count), y(count), level(count), left(count), top(count);
+    QRandomGenerator random(42);
+    for (int i = 0; i < count; ++i) {
+        x[i] = random.bounded(200);
+        y[i] = random.bounded(200);
+        level[i] = random.bounded(levels);
+    }
+
+    qint64 checksum = 0;
+    QElapsedTimer timer;
+
+    // the way games do it today, one getter call per metric and tile
+    timer.start();
+    for (int iteration = 0; iteration < iterations; ++iteration) {
+        for (int i = 0; i < count; ++i) {
+            left[i] = x[i] * tileset.qWidth() - level[i] * tileset.levelOffsetX() + (levels - 1) * tileset.levelOffsetX();
+            top[i] = y[i] * tileset.qHeight() - level[i] * tileset.levelOffsetY() + (levels - 1) * tileset.levelOffsetY();
+        }
+        checksum += left[iteration % count] + top[iteration % count];
+    }
+    printResult("per-tile getters", timer.nsecsElapsed(), iterations, count);
+
+    timer.start();
+    for (int iteration = 0; iteration < iterations; ++iteration) {
+        tileset.tilePositions(x, y, level, left, top, 1, levels);
+        checksum -= left[iteration % count] + top[iteration % count];
+    }
+    printResult("tilePositions()", timer.nsecsElapsed(), iterations, count);
+
+    // both calculate the same, so this should be 0
+    return checksum == 0 ? 0 : -1;
+}
+
+// times rendering into a fresh image of @p size, the way the library renders on a cache miss
+template<typename Paint>
+qint64 timeRendering(QSize size, int iterations, Paint paint)
+{
+    QElapsedTimer timer;
+    timer.start();
+    for (int iteration = 0; iteration < iterations; ++iteration) {
+        QImage image(size, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::transparent);
+        QPainter painter(&image);
+        paint(&painter);
+    }
+    return timer.nsecsElapsed();
+}
+
+void printDisplayListResult(const QString &theme, qint64 svgNanoSeconds, qint64 replayNanoSeconds, int renderCount)
+{
+    std::cout << qPrintable(theme) << ": QSvgRenderer " << (svgNanoSeconds / renderCount / 1000.0) << " us, display list " //
+              << (replayNanoSeconds / renderCount / 1000.0) << " us per render, speedup " //
+              << (static_cast<double>(svgNanoSeconds) / std::max<qint64>(1, replayNanoSeconds)) << std::endl;
+}
+
+int benchmarkDisplayList(const BenchmarkOptions &options)
+{
+    const int iterations = options.iterationsOr(10);
+    // twice the size of the elements in the file, like the master renderings of the library
+    constexpr qreal scale = 2.0;
+
+    for (const QString &theme : installedThemes(u"tilesets"_s)) {
+        const QString svgzFile = installedGraphicsFile(theme, u"KMahjonggTileset"_s, u"tilesets"_s);
+        QSvgRenderer renderer(svgzFile);
+        if (!renderer.isValid()) {
+            continue;
+        }
+        qint64 svgTime = 0;
+        qint64 replayTime = 0;
+        int renderCount = 0;
+        for (const QString &elementId : KMahjonggTileElements::idList()) {
+            const QSize size = (renderer.boundsOnElement(elementId).size() * scale).toSize();
+            if (size.isEmpty()) {
+                continue;
+            }
+            const QRectF bounds(QPointF(), QSizeF(size));
+            const KMahjonggDisplayList list = KMahjonggDisplayList::record(bounds.size(), [&renderer, &elementId, &bounds](QPainter *painter) {
+                renderer.render(painter, elementId, bounds);
+            });
+            svgTime += timeRendering(size, iterations, [&renderer, &elementId](QPainter *painter) {
+                renderer.render(painter, elementId);
+            });
+            replayTime += timeRendering(size, iterations, [&list, &bounds](QPainter *painter) {
+                list.replay(painter, bounds);
+            });
+            renderCount += iterations;
+        }
+        if (renderCount > 0) {
+            printDisplayListResult(theme, svgTime, replayTime, renderCount);
+        }
+    }
+
+    for (const QString &theme : installedThemes(u"backgrounds"_s)) {
+        const QString svgzFile = installedGraphicsFile(theme, u"KMahjonggBackground"_s, u"backgrounds"_s);
+        if (svgzFile.isEmpty()) {
+            // plain colour
+            continue;
+        }
+        QSvgRenderer renderer(svgzFile);
+        if (!renderer.isValid()) {
+            continue;
+        }
+        const QSize size(1920, 1080);
+        const QRectF bounds(QPointF(), QSizeF(size));
+        const KMahjonggDisplayList list = KMahjonggDisplayList::record(bounds.size(), [&renderer, &bounds](QPainter *painter) {
+            renderer.render(painter, bounds);
+        });
+        const qint64 svgTime = timeRendering(size, iterations, [&renderer](QPainter *painter) {
+            renderer.render(painter);
+        });
+        const qint64 replayTime = timeRendering(size, iterations, [&list, &bounds](QPainter *painter) {
+            list.replay(painter, bounds);
+        });
+        printDisplayListResult(theme, svgTime, replayTime, iterations);
+    }
+    return 0;
+}
+
+// reader threads look up warm images while writer threads keep inserting and removing
+// other entries of the same cache, like the paint and render threads of a game would
+int benchmarkConcurrent(const BenchmarkOptions &options)
+{
+    KMahjonggTileset tileset;
+    if (!loadTileset(tileset, options.tilesetPath)) {
+        return -1;
+    }
+
+    const int iterations = options.iterationsOr(1000);
+    KMahjonggSnapshotCache<QImage> cache;
+    QStringList keys;
+    for (int face = 0; face < KMahjonggTileset::FaceCount; ++face) {
+        const QString key = u"face_%1"_s.arg(face);
+        cache.insert(key, tileset.tilefaceImage(face, 1.0));
+        keys.append(key);
+    }
+    const QImage writtenImage = tileset.unselectedTileImage(0, 1.0);
+    // writers cycle through this many keys each, so the snapshots stay the size of the real caches
+    constexpr int keysPerWriter = 16;
+
+    for (int threadCount = 1; threadCount <= options.threadCount; threadCount *= 2) {
+        std::atomic<qint64> checksum = 0;
+        std::atomic<qint64> writeCount = 0;
+        std::atomic<bool> readersDone = false;
+        std::vector<std::thread> writers;
+        for (int writer = 0; writer < options.writerCount; ++writer) {
+            writers.emplace_back([&cache, &writtenImage, &writeCount, &readersDone, writer]() {
+                const QString prefix = u"writer_%1_"_s.arg(writer);
+                qint64 writes = 0;
+                while (!readersDone.load(std::memory_order_relaxed)) {
+                    const int slot = static_cast<int>(writes % keysPerWriter);
+                    cache.insert(prefix + QString::number(slot), writtenImage);
+                    if (slot == keysPerWriter - 1) {
+                        cache.removeIf([&prefix](const QString &key) {
+                            return key.startsWith(prefix);
+                        });
+                    }
+                    ++writes;
+                }
+                writeCount += writes;
+            });
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        std::vector<std::thread> readers;
+        for (int reader = 0; reader < threadCount; ++reader) {
+            readers.emplace_back([&cache, &keys, &checksum, iterations]() {
+                qint64 sum = 0;
+                for (int iteration = 0; iteration < iterations; ++iteration) {
+                    for (const QString &key : keys) {
+                        sum += cache.value(key).width();
+                    }
+                }
+                checksum += sum;
+            });
+        }
+        for (std::thread &reader : readers) {
+            reader.join();
+        }
+        const qint64 nanoSeconds = timer.nsecsElapsed();
+        readersDone = true;
+        for (std::thread &writer : writers) {
+            writer.join();
+        }
+
+        const qint64 lookups = static_cast<qint64>(threadCount) * iterations * keys.size();
+        std::cout << threadCount << " readers, " << options.writerCount << " writers: " //
+                  << (lookups * 1000.0 / nanoSeconds) << " M lookups/s, " //
+                  << (static_cast<double>(nanoSeconds) * threadCount / lookups) << " ns per lookup and reader, " //
+                  << (writeCount * 1000000.0 / nanoSeconds) << " k writes/s" << std::endl;
+        if (checksum == 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+}
+
+int main(int argc, char **argv)
+{
+    QGuiApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addPositionalArgument(u"benchmark"_s, u"Benchmark to run: layout, load, concurrent, displaylist"_s);
+    const QCommandLineOption tilesetOption(u"tileset"_s, u"Tileset .desktop file, the default tileset if not set"_s, u"file"_s);
+    parser.addOption(tilesetOption);
+    const QCommandLineOption tilesOption(u"tiles"_s, u"Number of tiles"_s, u"count"_s, u"4000"_s);
+    parser.addOption(tilesOption);
+    const QCommandLineOption iterationsOption(u"iterations"_s, u"Number of iterations, 1000 for layout and concurrent and 10 for load and displaylist by default"_s, u"count"_s);
+    parser.addOption(iterationsOption);
+    const QCommandLineOption threadsOption(u"threads"_s,
+                                           u"Maximum number of reader threads for concurrent, doubled from 1 on"_s,
+                                           u"count"_s,
+                                           QString::number(QThread::idealThreadCount()));
+    parser.addOption(threadsOption);
+    const QCommandLineOption writersOption(u"writers"_s, u"Number of writer threads for concurrent"_s, u"count"_s, u"1"_s);
+    parser.addOption(writersOption);
+
+    parser.process(app);
+
+    const QStringList args = parser.positionalArguments();
+
+    if (args.size() < 1) {
+        std::cout << qPrintable(parser.helpText());
+        return -1;
+    }
+
+    BenchmarkOptions options;
+    options.tilesetPath = parser.value(tilesetOption);
+    options.tileCount = std::max(1, parser.value(tilesOption).toInt());
+    options.iterations = std::max(0, parser.value(iterationsOption).toInt());
+    options.threadCount = std::max(1, parser.value(threadsOption).toInt());
+    options.writerCount = std::max(0, parser.value(writersOption).toInt());
+
+    const QString benchmark = args[0];
+    if (benchmark == "layout"_L1) {
+        return benchmarkLayout(options);
+    }
+    if (benchmark == "load"_L1) {
+        return benchmarkLoad(options);
+    }
+    if (benchmark == "concurrent"_L1) {
+        return benchmarkConcurrent(options);
+    }
+    if (benchmark == "displaylist"_L1) {
+        return benchmarkDisplayList(options);
+    }
+
+    std::cout << qPrintable(parser.helpText());
+    return -1;
+}
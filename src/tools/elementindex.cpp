@@ -0,0 +1,79 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+#include <QSvgRenderer>
+
+#include "kmahjonggelementhash_p.h"
+#include "kmahjonggtileelements_p.h"
+
+#include <iostream>
+
+using namespace Qt::Literals;
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addPositionalArgument(u"svg_file"_s, u"Input uncompressed tileset SVG file"_s);
+    parser.addPositionalArgument(u"index_file"_s, u"Output element index file"_s);
+
+    parser.process(app);
+
+    const QStringList args = parser.positionalArguments();
+
+    if (args.size() < 2) {
+        std::cout << qPrintable(parser.helpText());
+        return -1;
+    }
+
+    const QString inputPath = args[0];
+    const QString outputPath = args[1];
+
+    QSvgRenderer renderer(inputPath);
+    if (!renderer.isValid()) {
+        std::cerr << "Could not load " << qPrintable(inputPath) << std::endl;
+        return -1;
+    }
+
+    QFile svgFile(inputPath);
+    if (!svgFile.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+    const QStringList &ids = KMahjonggTileElements::idList();
+    const QHash<QString, QByteArray> hashes = KMahjonggElementHash::subtreeHashes(&svgFile, ids);
+
+    QJsonObject elements;
+    for (const QString &id : ids) {
+        if (!renderer.elementExists(id)) {
+            std::cerr << "Missing element " << qPrintable(id) << " in " << qPrintable(inputPath) << std::endl;
+            return -1;
+        }
+        QJsonObject element;
+        element[u"hash"_s] = QString::fromLatin1(hashes.value(id));
+        elements[id] = element;
+    }
+
+    QJsonObject index;
+    index[u"version"_s] = 1;
+    index[u"elements"_s] = elements;
+
+    QFile indexFile(outputPath);
+    if (!indexFile.open(QIODevice::WriteOnly)) {
+        std::cerr << "Could not write " << qPrintable(outputPath) << std::endl;
+        return -1;
+    }
+    indexFile.write(QJsonDocument(index).toJson(QJsonDocument::Compact));
+
+    return 0;
+}
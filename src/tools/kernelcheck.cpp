@@ -0,0 +1,84 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include <QColor>
+#include <QGuiApplication>
+#include <QImage>
+#include <QRandomGenerator>
+
+#include "kmahjonggimagekernels_p.h"
+
+#include <iostream>
+
+namespace
+{
+
+// random premultiplied pixels, with fully transparent and opaque ones mixed in
+QImage randomImage(QRandomGenerator &random, int width, int height)
+{
+    QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < height; ++y) {
+        auto *line = reinterpret_cast<quint32 *>(image.scanLine(y));
+        for (int x = 0; x < width; ++x) {
+            const int kind = random.bounded(4);
+            const int alpha = (kind == 0) ? 0 : (kind == 1) ? 255 : random.bounded(256);
+            line[x] = qRgba(random.bounded(alpha + 1), random.bounded(alpha + 1), random.bounded(alpha + 1), alpha);
+        }
+    }
+    return image;
+}
+
+bool reportDifference(const char *kernel, const QImage &simd, const QImage &reference)
+{
+    if (simd == reference) {
+        return false;
+    }
+    std::cerr << kernel << " differs from its reference for size " << reference.width() << "x" << reference.height() << std::endl;
+    return true;
+}
+
+}
+
+// checks the SIMD code paths of the image kernels against their plain ones
+int main(int argc, char **argv)
+{
+    QGuiApplication app(argc, argv);
+
+    QRandomGenerator random(1);
+    const QColor tints[] = {Qt::red, QColor(40, 120, 255), Qt::white, Qt::black};
+    const qreal strengths[] = {0.1, 0.35, 0.5, 1.0};
+
+    int failures = 0;
+    // small sizes cover the scalar tails of every vector loop, both odd and even
+    for (int height = 1; height <= 9; ++height) {
+        for (int width = 1; width <= 37; ++width) {
+            const QImage image = randomImage(random, width, height);
+
+            failures += reportDifference("halved()", KMahjonggImageKernels::halved(image), KMahjonggImageKernels::halvedReference(image));
+
+            for (const QColor &color : tints) {
+                for (const qreal strength : strengths) {
+                    QImage tinted = image;
+                    KMahjonggImageKernels::tint(tinted, color, strength);
+                    QImage reference = image;
+                    KMahjonggImageKernels::tintReference(reference, color, strength);
+                    failures += reportDifference("tint()", tinted, reference);
+                }
+            }
+        }
+    }
+
+    // and one of the sizes actually used
+    const QImage master = randomImage(random, 192, 232);
+    failures += reportDifference("halved()", KMahjonggImageKernels::halved(master), KMahjonggImageKernels::halvedReference(master));
+
+    if (failures > 0) {
+        std::cerr << failures << " differences" << std::endl;
+        return 1;
+    }
+    std::cout << "SIMD and reference image kernels agree" << std::endl;
+    return 0;
+}
@@ -11,6 +11,8 @@
 #include <QString>
 #include <QSvgRenderer>
 
+#include "kmahjonggimagekernels_p.h"
+
 #include <iostream>
 
 using namespace Qt::Literals;
@@ -26,6 +28,10 @@ int main(int argc, char **argv)
     parser.addPositionalArgument(u"width"_s, u"Width"_s);
     parser.addPositionalArgument(u"height"_s, u"Height"_s);
     parser.addPositionalArgument(u"png_file"_s, u"Output PNG file"_s);
+    const QCommandLineOption masterSizeOption(u"master-size"_s,
+                                              u"Render at this size and downsample to width x height like KMahjonggTileset does"_s,
+                                              u"WxH"_s);
+    parser.addOption(masterSizeOption);
 
     parser.process(app);
 
@@ -41,8 +47,17 @@ int main(int argc, char **argv)
     const QString inputPath = args[0];
     const QString elementId = args[1];
     const QString outputPath = args[4];
+    QSize renderSize(width, height);
+    if (parser.isSet(masterSizeOption)) {
+        const QStringList masterSize = parser.value(masterSizeOption).split(u'x');
+        renderSize = (masterSize.size() == 2) ? QSize(masterSize[0].toInt(), masterSize[1].toInt()) : QSize();
+        if (renderSize.isEmpty()) {
+            std::cout << qPrintable(parser.helpText());
+            return -1;
+        }
+    }
 
-    QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
+    QImage image(renderSize, QImage::Format_ARGB32_Premultiplied);
     image.fill(Qt::transparent);
 
     QSvgRenderer renderer(inputPath);
@@ -56,6 +71,11 @@ int main(int argc, char **argv)
     } else {
         renderer.render(&p, elementId);
     }
+    p.end();
+
+    if (renderSize != QSize(width, height)) {
+        image = KMahjonggImageKernels::downsampled(image, QSize(width, height));
+    }
 
     image.save(outputPath, "PNG");
 
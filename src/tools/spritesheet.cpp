@@ -0,0 +1,172 @@
+/*
+    SPDX-FileCopyrightText: 2026 The KDE Games Team
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include <QCommandLineParser>
+#include <QFile>
+#include <QFileInfo>
+#include <QGuiApplication>
+#include <QImage>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPainter>
+#include <QString>
+#include <QSvgRenderer>
+
+#include "kmahjonggelementhash_p.h"
+#include "kmahjonggtileelements_p.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+using namespace Qt::Literals;
+
+namespace
+{
+
+// elements per row of a sheet
+constexpr int columnCount = 8;
+
+// renders all elements at @p scale into one image, adding their rects by element id to @p rects
+QImage renderSheet(QSvgRenderer &renderer, const QStringList &ids, const QHash<QString, QRectF> &bounds, qreal scale, QJsonObject *rects)
+{
+    QList<QSize> sizes;
+    int cellWidth = 0;
+    for (const QString &id : ids) {
+        const QRectF elementBounds = bounds.value(id);
+        const QSize size(std::max(1, qRound(elementBounds.width() * scale)), std::max(1, qRound(elementBounds.height() * scale)));
+        sizes.append(size);
+        cellWidth = std::max(cellWidth, size.width());
+    }
+
+    // shelves of columnCount elements, each as high as its highest element
+    QList<QPoint> positions;
+    int y = 0;
+    int sheetHeight = 0;
+    for (int row = 0; row * columnCount < sizes.size(); ++row) {
+        int rowHeight = 0;
+        for (int column = 0; column < columnCount && row * columnCount + column < sizes.size(); ++column) {
+            positions.append(QPoint(column * cellWidth, y));
+            rowHeight = std::max(rowHeight, sizes.at(row * columnCount + column).height());
+        }
+        y += rowHeight;
+        sheetHeight = y;
+    }
+
+    QImage sheet(cellWidth * columnCount, sheetHeight, QImage::Format_ARGB32_Premultiplied);
+    sheet.fill(Qt::transparent);
+    for (int i = 0; i < ids.size(); ++i) {
+        // rendered on its own like done by KMahjonggTileset, so nothing bleeds into the neighbours
+        QImage element(sizes.at(i), QImage::Format_ARGB32_Premultiplied);
+        element.fill(Qt::transparent);
+        QPainter elementPainter(&element);
+        renderer.render(&elementPainter, ids.at(i));
+        elementPainter.end();
+
+        QPainter sheetPainter(&sheet);
+        sheetPainter.setCompositionMode(QPainter::CompositionMode_Source);
+        sheetPainter.drawImage(positions.at(i), element);
+
+        const QRect rect(positions.at(i), sizes.at(i));
+        rects->insert(ids.at(i), QJsonArray{rect.x(), rect.y(), rect.width(), rect.height()});
+    }
+    return sheet;
+}
+
+}
+
+int main(int argc, char **argv)
+{
+    QGuiApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addPositionalArgument(u"svg_file"_s, u"Input uncompressed tileset SVG file"_s);
+    parser.addPositionalArgument(u"index_file"_s, u"Output sprite sheet index file, the sheets are written next to it"_s);
+    const QCommandLineOption scaleOption(u"scale"_s, u"Scale of the largest sheet, relative to the SVG document (default: 4)"_s, u"factor"_s, u"4"_s);
+    parser.addOption(scaleOption);
+    const QCommandLineOption levelsOption(u"levels"_s, u"Number of sheets, each with half the resolution of the previous (default: 4)"_s, u"count"_s, u"4"_s);
+    parser.addOption(levelsOption);
+
+    parser.process(app);
+
+    const QStringList args = parser.positionalArguments();
+
+    if (args.size() < 2) {
+        std::cout << qPrintable(parser.helpText());
+        return -1;
+    }
+
+    const QString inputPath = args[0];
+    const QString outputPath = args[1];
+    const qreal scale = parser.value(scaleOption).toDouble();
+    const int levels = parser.value(levelsOption).toInt();
+    if (scale <= 0 || levels < 1) {
+        std::cout << qPrintable(parser.helpText());
+        return -1;
+    }
+
+    QSvgRenderer renderer(inputPath);
+    if (!renderer.isValid()) {
+        std::cerr << "Could not load " << qPrintable(inputPath) << std::endl;
+        return -1;
+    }
+
+    QFile svgFile(inputPath);
+    if (!svgFile.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+    const QStringList &ids = KMahjonggTileElements::idList();
+    const QHash<QString, QByteArray> hashes = KMahjonggElementHash::subtreeHashes(&svgFile, ids);
+
+    QHash<QString, QRectF> bounds;
+    QJsonObject elements;
+    for (const QString &id : ids) {
+        if (!renderer.elementExists(id)) {
+            std::cerr << "Missing element " << qPrintable(id) << " in " << qPrintable(inputPath) << std::endl;
+            return -1;
+        }
+        bounds.insert(id, renderer.transformForElement(id).mapRect(renderer.boundsOnElement(id)));
+        // same hashes as in the element index, so the caches of both formats agree on changed elements
+        elements[id] = QJsonObject{{u"hash"_s, QString::fromLatin1(hashes.value(id))}};
+    }
+
+    // "name.sprites.json" gets the sheets "name.0.png", "name.1.png", ...
+    const QFileInfo outputInfo(outputPath);
+    QString baseName = outputInfo.fileName();
+    if (baseName.endsWith(u".sprites.json"_s)) {
+        baseName.chop(13);
+    } else {
+        baseName = outputInfo.completeBaseName();
+    }
+
+    QJsonArray sheets;
+    for (int level = 0; level < levels; ++level) {
+        QJsonObject rects;
+        const QImage sheet = renderSheet(renderer, ids, bounds, scale / std::pow(2.0, level), &rects);
+        const QString sheetFileName = baseName + u'.' + QString::number(level) + u".png"_s;
+        if (!sheet.save(outputInfo.absolutePath() + u'/' + sheetFileName, "PNG")) {
+            std::cerr << "Could not write " << qPrintable(sheetFileName) << std::endl;
+            return -1;
+        }
+        sheets.append(QJsonObject{{u"file"_s, sheetFileName}, {u"elements"_s, rects}});
+    }
+
+    QJsonObject index;
+    index[u"version"_s] = 1;
+    index[u"elements"_s] = elements;
+    index[u"sheets"_s] = sheets;
+
+    QFile indexFile(outputPath);
+    if (!indexFile.open(QIODevice::WriteOnly)) {
+        std::cerr << "Could not write " << qPrintable(outputPath) << std::endl;
+        return -1;
+    }
+    indexFile.write(QJsonDocument(index).toJson(QJsonDocument::Compact));
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+# SPDX-FileCopyrightText: 2026 The KDE Games Team
+#
+# SPDX-License-Identifier: BSD-3-Clause
+
+# compares direct renderings of all elements with ones derived from the master renderings,
+# like KMahjonggTileset renders them at twice the size of the desktop file and downsamples them,
+# failing if the normalized mean absolute error of any exceeds MAX_MAE
+
+set(id ${ID})
+set(render_tool ${RENDERELEMENT})
+set(rcompare_tool ${COMPARE})
+set(svg_file ${SVG_FILE})
+set(desktop_file ${DESKTOP_FILE})
+set(work_dir "${WORKING_DIR}/${id}/check_mipmaps")
+if(DEFINED MAX_MAE)
+    set(max_mae ${MAX_MAE})
+else()
+    set(max_mae 0.02)
+endif()
+
+# no float comparison in CMake, so compare numbers like 0.0188 as integer millionths
+function(to_millionths result_var value)
+    if (NOT value MATCHES "^([0-9]+)(\\.([0-9]*))?$")
+        message(FATAL_ERROR "Not a decimal number: ${value}")
+    endif()
+    string(SUBSTRING "${CMAKE_MATCH_3}000000" 0 6 fraction)
+    math(EXPR result "${CMAKE_MATCH_1} * 1000000 + 1${fraction} - 1000000")
+    set(${result_var} ${result} PARENT_SCOPE)
+endfunction()
+to_millionths(max_mae_millionths "${max_mae}")
+
+foreach(file "${svg_file}" "${desktop_file}")
+    if (NOT EXISTS "${file}")
+        message(FATAL_ERROR "File ${file} does not exist")
+    endif()
+endforeach()
+
+# sizes as given in the desktop file, see KMahjonggTileset
+foreach(key TileWidth TileHeight TileFaceWidth TileFaceHeight)
+    file(STRINGS "${desktop_file}" line REGEX "^${key}=[0-9]+$")
+    if (NOT line)
+        message(FATAL_ERROR "No ${key} in ${desktop_file}")
+    endif()
+    string(REGEX REPLACE "^${key}=" "" ${key} "${line}")
+endforeach()
+
+include(${CMAKE_CURRENT_LIST_DIR}/TileElementIds.cmake)
+
+# ensure working dir
+make_directory(${work_dir})
+
+set(failures)
+foreach(t ${tile_ids})
+    if (t MATCHES "^TILE_")
+        set(width ${TileWidth})
+        set(height ${TileHeight})
+    else()
+        set(width ${TileFaceWidth})
+        set(height ${TileFaceHeight})
+    endif()
+    math(EXPR master_width "${width} * 2")
+    math(EXPR master_height "${height} * 2")
+
+    # the desktop file size is one plain halving, the others a halving followed by smooth scaling
+    foreach(scale 4 3 1)
+        if (scale EQUAL 1)
+            # a bit below a third of the size, so close to two halvings
+            math(EXPR target_width "(${width} * 3 + 5) / 10")
+            math(EXPR target_height "(${height} * 3 + 5) / 10")
+        else()
+            math(EXPR target_width "(${width} * ${scale} + 2) / 4")
+            math(EXPR target_height "(${height} * ${scale} + 2) / 4")
+        endif()
+        set(size "${target_width}x${target_height}")
+
+        set(direct_png_file "${t}_direct_${size}.png")
+        execute_process(
+            COMMAND ${render_tool} ${svg_file} ${t} ${target_width} ${target_height} ${direct_png_file}
+            WORKING_DIRECTORY ${work_dir}
+        )
+        set(derived_png_file "${t}_derived_${size}.png")
+        execute_process(
+            COMMAND ${render_tool} --master-size ${master_width}x${master_height}
+                ${svg_file} ${t} ${target_width} ${target_height} ${derived_png_file}
+            WORKING_DIRECTORY ${work_dir}
+        )
+
+        # compare, prints the absolute and in parentheses the normalized error
+        execute_process(
+            COMMAND ${rcompare_tool}
+                -metric MAE
+                ${direct_png_file}
+                ${derived_png_file}
+                /dev/null # no use for difference image
+            WORKING_DIRECTORY ${work_dir}
+            OUTPUT_VARIABLE compare_output
+            ERROR_VARIABLE compare_output
+        )
+        string(REGEX MATCH "\\(([0-9.]+(e-[0-9]+)?)\\)" compare_match "${compare_output}")
+        if (NOT compare_match)
+            message(FATAL_ERROR "Could not compare ${id}, element ${t} at ${size}: ${compare_output}")
+        endif()
+        set(mae ${CMAKE_MATCH_1})
+        message(STATUS "Difference for ${id}, element ${t} at ${size}: ${mae}")
+
+        # tiny values in exponent notation are below any sensible threshold
+        if (NOT mae MATCHES "e-")
+            to_millionths(mae_millionths "${mae}")
+            if (mae_millionths GREATER max_mae_millionths)
+                list(APPEND failures "${t} at ${size}: ${mae}")
+            endif()
+        endif()
+    endforeach()
+endforeach()
+
+if (failures)
+    list(JOIN failures "\n  " failures_text)
+    message(FATAL_ERROR "Derived elements of ${id} differ by more than ${max_mae}:\n  ${failures_text}")
+endif()
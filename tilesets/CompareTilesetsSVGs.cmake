@@ -16,41 +16,7 @@ if (NOT EXISTS "${new_file}")
     message(FATAL_ERROR "New file ${new_file} does not exist")
 endif()
 
-# generate list of card element ids
-set(tile_ids)
-
-# Unselected tiles
-foreach(i RANGE 1 4)
-    list(APPEND tile_ids "TILE_${i}")
-endforeach()
-
-# Selected tiles
-foreach(i RANGE 1 4)
-    list(APPEND tile_ids "TILE_${i}_SEL")
-endforeach()
-
-# now faces
-foreach(i RANGE 1 9)
-    list(APPEND tile_ids "CHARACTER_${i}")
-endforeach()
-foreach(i RANGE 1 9)
-    list(APPEND tile_ids "BAMBOO_${i}")
-endforeach()
-foreach(i RANGE 1 9)
-    list(APPEND tile_ids "ROD_${i}")
-endforeach()
-foreach(i RANGE 1 4)
-    list(APPEND tile_ids "SEASON_${i}")
-endforeach()
-foreach(i RANGE 1 4)
-    list(APPEND tile_ids "WIND_${i}")
-endforeach()
-foreach(i RANGE 1 3)
-    list(APPEND tile_ids "DRAGON_${i}")
-endforeach()
-foreach(i RANGE 1 4)
-    list(APPEND tile_ids "FLOWER_${i}")
-endforeach()
+include(${CMAKE_CURRENT_LIST_DIR}/TileElementIds.cmake)
 
 # ensure working dir
 make_directory(${work_dir})